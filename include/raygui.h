@@ -97,6 +97,9 @@
 *       a custom icons set could be loaded over this array using GuiLoadIcons(), but loaded icons set
 *       must be same RAYGUI_ICON_SIZE and no more than RAYGUI_ICON_MAX_ICONS will be loaded
 *
+*       Icons are drawn from an atlas texture created on first GuiDrawIcon(), call GuiUnloadIcons()
+*       before CloseWindow() to release it
+*
 *       Every icon is codified in binary form, using 1 bit per pixel, so, every 16x16 icon
 *       requires 8 integers (16*16/32) to be stored in memory.
 *
@@ -365,6 +368,9 @@
 #ifndef RAYGUI_CALLOC
     #define RAYGUI_CALLOC(n,sz)     calloc(n,sz)
 #endif
+#ifndef RAYGUI_REALLOC
+    #define RAYGUI_REALLOC(p,sz)    realloc(p,sz)
+#endif
 #ifndef RAYGUI_FREE
     #define RAYGUI_FREE(p)          free(p)
 #endif
@@ -467,6 +473,10 @@ typedef struct GuiStyleProp {
     int propertyValue;          // Property value
 } GuiStyleProp;
 
+// List view item provider, returns text of item index
+// NOTE: Returned text is only used until the next call, a static buffer is enough
+typedef const char *(*GuiListItemCallback)(int index, void *userData);
+
 /*
 // Controls text style -NOT USED-
 // NOTE: Text style is defined by control
@@ -715,6 +725,7 @@ RAYGUIAPI void GuiSetIconScale(int scale);                      // Set default i
 RAYGUIAPI unsigned int *GuiGetIcons(void);                      // Get raygui icons data pointer
 RAYGUIAPI char **GuiLoadIcons(const char *fileName, bool loadIconsName); // Load raygui icons file (.rgi) into internal icons data
 RAYGUIAPI void GuiDrawIcon(int iconId, int posX, int posY, int pixelSize, Color color); // Draw icon using pixel size at specified position
+RAYGUIAPI void GuiUnloadIcons(void);                            // Unload icons atlas texture, icons data is kept
 #endif
 
 // Controls
@@ -753,6 +764,7 @@ RAYGUIAPI int GuiGrid(Rectangle bounds, const char *text, float spacing, int sub
 // Advance controls set
 RAYGUIAPI int GuiListView(Rectangle bounds, const char *text, int *scrollIndex, int *active);          // List View control
 RAYGUIAPI int GuiListViewEx(Rectangle bounds, const char **text, int count, int *scrollIndex, int *active, int *focus); // List View with extended parameters
+RAYGUIAPI int GuiListViewVirtual(Rectangle bounds, GuiListItemCallback getItem, void *userData, int count, int *scrollIndex, int *active, int *focus); // List View requesting only visible items text
 RAYGUIAPI int GuiMessageBox(Rectangle bounds, const char *title, const char *message, const char *buttons); // Message Box control, displays a message
 RAYGUIAPI int GuiTextInputBox(Rectangle bounds, const char *title, const char *message, const char *buttons, char *text, int textMaxSize, bool *secretViewActive); // Text Input Box control, ask for text, supports secret
 RAYGUIAPI int GuiColorPicker(Rectangle bounds, const char *text, Color *color);                        // Color Picker control (multiple color controls)
@@ -1046,11 +1058,12 @@ typedef enum {
 #if defined(RAYGUI_IMPLEMENTATION)
 
 #include <ctype.h>              // required for: isspace() [GuiTextBox()]
-#include <stdio.h>              // Required for: FILE, fopen(), fclose(), fprintf(), feof(), fscanf(), vsprintf() [GuiLoadStyle(), GuiLoadIcons()]
-#include <stdlib.h>             // Required for: malloc(), calloc(), free() [GuiLoadStyle(), GuiLoadIcons()]
+#include <stdio.h>              // Required for: FILE, fopen(), fclose(), fprintf(), feof(), fscanf(), vsnprintf() [GuiLoadStyle(), GuiLoadIcons(), TextFormat()]
+#include <stdlib.h>             // Required for: malloc(), calloc(), realloc(), free() [GuiLoadStyle(), GuiLoadIcons(), GuiTextSplit()]
 #include <string.h>             // Required for: strlen() [GuiTextBox(), GuiValueBox()], memset(), memcpy()
 #include <stdarg.h>             // Required for: va_list, va_start(), vfprintf(), va_end() [TextFormat()]
 #include <math.h>               // Required for: roundf() [GuiColorPicker()]
+#include <limits.h>             // Required for: INT_MAX [GuiReserve()]
 
 #ifdef __cplusplus
     #define RAYGUI_CLITERAL(name) name
@@ -1352,6 +1365,15 @@ static unsigned int *guiIconsPtr = guiIcons;
 
 #endif      // !RAYGUI_NO_ICONS && !RAYGUI_CUSTOM_ICONS
 
+#if !defined(RAYGUI_NO_ICONS) && !defined(RAYGUI_STANDALONE)
+// Icons atlas texture, icons rasterized in rows of 16, drawn one quad per icon
+// NOTE: Uploaded lazily on first GuiDrawIcon(), once a graphics context exists
+#define RAYGUI_ICONS_ATLAS_COLUMNS      16
+
+static Texture2D guiIconsTexture = { 0 };
+static bool guiIconsTextureDirty = true;        // Icons data changed since last atlas upload
+#endif
+
 #ifndef RAYGUI_ICON_SIZE
     #define RAYGUI_ICON_SIZE             0
 #endif
@@ -1362,12 +1384,53 @@ static unsigned int *guiIconsPtr = guiIcons;
 #define RAYGUI_MAX_PROPS_BASE           16      // Maximum number of base properties
 #define RAYGUI_MAX_PROPS_EXTENDED        8      // Maximum number of extended properties
 
+// Codepoint to glyph index table of the gui font, two levels of pages
+#define RAYGUI_GLYPH_PAGE_SIZE         256
+#define RAYGUI_GLYPH_PAGE_COUNT     (0x110000/RAYGUI_GLYPH_PAGE_SIZE)
+
+// Text split results cached by GuiTextSplit(), one per split text pointer
+#if !defined(RAYGUI_TEXTSPLIT_CACHE_SIZE)
+    #define RAYGUI_TEXTSPLIT_CACHE_SIZE      8
+#endif
+
+// Text width cache entries used by GetTextWidth(), must be a power of two
+#if !defined(RAYGUI_TEXT_WIDTH_CACHE_SIZE)
+    #define RAYGUI_TEXT_WIDTH_CACHE_SIZE   256
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
 // Gui control property style color element
 typedef enum { BORDER = 0, BASE, TEXT, OTHER } GuiPropertyElement;
 
+// Gui measured text line width, keyed by everything the width depends on
+typedef struct GuiTextWidthEntry {
+    bool valid;                 // Entry holds a measurement
+    unsigned long long hash;    // FNV-1a hash of the line bytes (icon excluded)
+    int length;                 // Line length in bytes
+    unsigned int fontId;        // Font texture id
+    int fontSize;               // TEXT_SIZE used
+    int spacing;                // TEXT_SPACING used
+    float width;                // Measured width, icon excluded
+} GuiTextWidthEntry;
+
+// Gui split text, items point into its own copy of the text
+typedef struct GuiTextSplitEntry {
+    const char *source;         // Split text pointer, NULL if entry not used
+    char delimiter;             // Delimiter used
+    unsigned long long hash;    // FNV-1a hash of the text, the same pointer could hold another text
+    int length;                 // Text length in bytes
+    int count;                  // Number of items
+    unsigned int lastUse;       // Split counter at last use, oldest entry is replaced
+    char *buffer;               // Text copy with '\0' at every delimiter
+    const char **items;         // Items pointers into buffer
+    int *rows;                  // Row of every item, rows are separated by '\n'
+    int bufferCapacity;         // Allocated bytes, only grow
+    int itemsCapacity;
+    int rowsCapacity;
+} GuiTextSplitEntry;
+
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
@@ -1406,6 +1469,37 @@ static unsigned int guiStyle[RAYGUI_MAX_CONTROLS*(RAYGUI_MAX_PROPS_BASE + RAYGUI
 
 static bool guiStyleLoaded = false;         // Style loaded flag for lazy style initialization
 
+//----------------------------------------------------------------------------------
+// Text width cache, GetTextWidth() results for recently measured lines
+//
+// NOTE: Labels rarely change between frames, measuring them again means decoding
+// UTF-8 and searching every glyph of the font. Style properties are part of the key,
+// so changing them needs no flush; font changes clear the cache because a reloaded
+// font can get the same texture id
+//----------------------------------------------------------------------------------
+static GuiTextWidthEntry guiTextWidthCache[RAYGUI_TEXT_WIDTH_CACHE_SIZE] = { 0 };
+
+//----------------------------------------------------------------------------------
+// Text split cache, GuiTextSplit() results of recently split control texts
+//
+// NOTE: Controls split the same text every frame, a hit only hashes the text. Buffers
+// are kept and grow as needed, so there is no limit on items or text size and
+// steady state splitting does not allocate
+//----------------------------------------------------------------------------------
+static GuiTextSplitEntry guiTextSplitCache[RAYGUI_TEXTSPLIT_CACHE_SIZE] = { 0 };
+static unsigned int guiTextSplitCounter = 0;    // Number of GuiTextSplit() calls, for entries age
+
+//----------------------------------------------------------------------------------
+// Glyph lookup table for guiFont, rebuilt whenever the font is set
+//
+// NOTE: GetGlyphIndex() scans all font glyphs for every codepoint, too slow for fonts
+// with thousands of CJK glyphs. Codepoints are split in pages of 256, only pages with
+// at least one glyph are allocated, the rest resolve to the fallback glyph
+//----------------------------------------------------------------------------------
+static int guiGlyphPages[RAYGUI_GLYPH_PAGE_COUNT] = { 0 };  // Page offset into guiGlyphTable per codepoint page, -1 if empty
+static int *guiGlyphTable = NULL;               // Glyph index per codepoint of the allocated pages
+static int guiGlyphFallback = 0;                // Glyph index for codepoints missing in the font ('?')
+
 //----------------------------------------------------------------------------------
 // Standalone Mode Functions Declaration
 //
@@ -1485,17 +1579,26 @@ static void DrawRectangleGradientV(int posX, int posY, int width, int height, Co
 static void GuiLoadStyleFromMemory(const unsigned char *fileData, int dataSize);    // Load style from memory (binary only)
 
 static int GetTextWidth(const char *text);                      // Gui get text width using gui font and style
+static void ClearTextWidthCache(void);                          // Forget all measured text widths, required on font change
+static void LoadGlyphTable(void);                               // Build codepoint to glyph index table for current gui font
+static int GetGuiGlyphIndex(int codepoint);                     // Get gui font glyph index for a codepoint, using glyph table
+static void GuiDrawGlyph(int index, Vector2 position, float fontSize, Color tint);  // Draw gui font glyph by index
 static Rectangle GetTextBounds(int control, Rectangle bounds);  // Get text bounds considering control bounds
 static const char *GetTextIcon(const char *text, int *iconId);  // Get text icon if provided and move text cursor
 
 static void GuiDrawText(const char *text, Rectangle textBounds, int alignment, Color tint);     // Gui draw text using default font
 static void GuiDrawRectangle(Rectangle rec, int borderWidth, Color borderColor, Color color);   // Gui draw rectangle using default raygui style
 
-static const char **GuiTextSplit(const char *text, char delimiter, int *count, int *textRow);   // Split controls text into multiple strings
+// NOTE: Returned items (and rows) are owned by the split cache, they stay valid until
+// RAYGUI_TEXTSPLIT_CACHE_SIZE other texts have been split or the same text pointer is split
+// again with different contents, count is 0 if memory for the split could not be allocated
+static const char **GuiTextSplit(const char *text, char delimiter, int *count, const int **textRows); // Split controls text into multiple strings
+static void *GuiReserve(void *buffer, int *capacity, size_t size); // Grow buffer to at least size bytes, keeps contents, NULL on failure
 static Vector3 ConvertHSVtoRGB(Vector3 hsv);                    // Convert color data from HSV to RGB
 static Vector3 ConvertRGBtoHSV(Vector3 rgb);                    // Convert color data from RGB to HSV
 
 static int GuiScrollBar(Rectangle bounds, int value, int minValue, int maxValue);   // Scroll bar control, used by GuiScrollPanel()
+static const char *GetListItemText(int index, void *userData);  // List view item provider over a text array, used by GuiListViewEx()
 static void GuiTooltip(Rectangle controlRec);                   // Draw tooltip using control rec position
 
 static Color GuiFade(Color color, float alpha);         // Fade color by an alpha factor
@@ -1547,6 +1650,8 @@ void GuiSetFont(Font font)
         if (!guiStyleLoaded) GuiLoadStyleDefault();
 
         guiFont = font;
+        ClearTextWidthCache();
+        LoadGlyphTable();
     }
 }
 
@@ -2090,10 +2195,6 @@ int GuiToggle(Rectangle bounds, const char *text, bool *active)
 // Toggle Group control
 int GuiToggleGroup(Rectangle bounds, const char *text, int *active)
 {
-    #if !defined(RAYGUI_TOGGLEGROUP_MAX_ITEMS)
-        #define RAYGUI_TOGGLEGROUP_MAX_ITEMS    32
-    #endif
-
     int result = 0;
     float initBoundsX = bounds.x;
 
@@ -2103,9 +2204,9 @@ int GuiToggleGroup(Rectangle bounds, const char *text, int *active)
     bool toggle = false;    // Required for individual toggles
 
     // Get substrings items from text (items pointers)
-    int rows[RAYGUI_TOGGLEGROUP_MAX_ITEMS] = { 0 };
+    const int *rows = NULL;
     int itemCount = 0;
-    const char **items = GuiTextSplit(text, ';', &itemCount, rows);
+    const char **items = GuiTextSplit(text, ';', &itemCount, &rows);
 
     int prevRow = rows[0];
 
@@ -2295,8 +2396,9 @@ int GuiComboBox(Rectangle bounds, const char *text, int *active)
     int itemCount = 0;
     const char **items = GuiTextSplit(text, ';', &itemCount, NULL);
 
+    // NOTE: An empty split (allocation failure) keeps active at 0, its item 0 is ""
+    if (*active > (itemCount - 1)) *active = itemCount - 1;
     if (*active < 0) *active = 0;
-    else if (*active > (itemCount - 1)) *active = itemCount - 1;
 
     // Update control
     //--------------------------------------------------------------------
@@ -2706,7 +2808,7 @@ int GuiTextBox(Rectangle bounds, char *text, int textSize, bool editMode)
                 for (int i = textIndexOffset; i < textLength; i++)
                 {
                     codepoint = GetCodepointNext(&text[i], &codepointSize);
-                    codepointIndex = GetGlyphIndex(guiFont, codepoint);
+                    codepointIndex = GetGuiGlyphIndex(codepoint);
 
                     if (guiFont.glyphs[codepointIndex].advanceX == 0) glyphWidth = ((float)guiFont.recs[codepointIndex].width*scaleFactor);
                     else glyphWidth = ((float)guiFont.glyphs[codepointIndex].advanceX*scaleFactor);
@@ -3387,6 +3489,13 @@ int GuiListView(Rectangle bounds, const char *text, int *scrollIndex, int *activ
 
 // List View control with extended parameters
 int GuiListViewEx(Rectangle bounds, const char **text, int count, int *scrollIndex, int *active, int *focus)
+{
+    return GuiListViewVirtual(bounds, (text != NULL)? GetListItemText : NULL, (void *)text, count, scrollIndex, active, focus);
+}
+
+// List View control requesting only visible items text
+// NOTE: All items have the same height, so the cost does not depend on items count
+int GuiListViewVirtual(Rectangle bounds, GuiListItemCallback getItem, void *userData, int count, int *scrollIndex, int *active, int *focus)
 {
     int result = 0;
     GuiState state = guiState;
@@ -3396,7 +3505,7 @@ int GuiListViewEx(Rectangle bounds, const char **text, int count, int *scrollInd
 
     // Check if we need a scroll bar
     bool useScrollBar = false;
-    if ((GuiGetStyle(LISTVIEW, LIST_ITEMS_HEIGHT) + GuiGetStyle(LISTVIEW, LIST_ITEMS_SPACING))*count > bounds.height) useScrollBar = true;
+    if ((float)(GuiGetStyle(LISTVIEW, LIST_ITEMS_HEIGHT) + GuiGetStyle(LISTVIEW, LIST_ITEMS_SPACING))*count > bounds.height) useScrollBar = true;
 
     // Define base item rectangle [0]
     Rectangle itemBounds = { 0 };
@@ -3425,22 +3534,23 @@ int GuiListViewEx(Rectangle bounds, const char **text, int count, int *scrollInd
         {
             state = STATE_FOCUSED;
 
-            // Check focused and selected item
-            for (int i = 0; i < visibleItems; i++)
+            // Check focused and selected item, row under mouse from fixed item height
+            float rowHeight = (float)(GuiGetStyle(LISTVIEW, LIST_ITEMS_HEIGHT) + GuiGetStyle(LISTVIEW, LIST_ITEMS_SPACING));
+            int row = (mousePoint.y >= itemBounds.y)? (int)((mousePoint.y - itemBounds.y)/rowHeight) : -1;
+
+            if ((row >= 0) && (row < visibleItems))
             {
+                itemBounds.y += row*rowHeight;
+
                 if (CheckCollisionPointRec(mousePoint, itemBounds))
                 {
-                    itemFocused = startIndex + i;
+                    itemFocused = startIndex + row;
                     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
                     {
-                        if (itemSelected == (startIndex + i)) itemSelected = -1;
-                        else itemSelected = startIndex + i;
+                        if (itemSelected == (startIndex + row)) itemSelected = -1;
+                        else itemSelected = startIndex + row;
                     }
-                    break;
                 }
-
-                // Update item rectangle y position for next item
-                itemBounds.y += (GuiGetStyle(LISTVIEW, LIST_ITEMS_HEIGHT) + GuiGetStyle(LISTVIEW, LIST_ITEMS_SPACING));
             }
 
             if (useScrollBar)
@@ -3467,15 +3577,17 @@ int GuiListViewEx(Rectangle bounds, const char **text, int count, int *scrollInd
     GuiDrawRectangle(bounds, GuiGetStyle(LISTVIEW, BORDER_WIDTH), GetColor(GuiGetStyle(LISTVIEW, BORDER + state*3)), GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));     // Draw background
 
     // Draw visible items
-    for (int i = 0; ((i < visibleItems) && (text != NULL)); i++)
+    for (int i = 0; ((i < visibleItems) && (getItem != NULL)); i++)
     {
+        const char *itemText = getItem(startIndex + i, userData);
+
         GuiDrawRectangle(itemBounds, GuiGetStyle(LISTVIEW, LIST_ITEMS_BORDER_WIDTH), GetColor(GuiGetStyle(LISTVIEW, BORDER_COLOR_NORMAL)), BLANK);
 
         if (state == STATE_DISABLED)
         {
             if ((startIndex + i) == itemSelected) GuiDrawRectangle(itemBounds, GuiGetStyle(LISTVIEW, BORDER_WIDTH), GetColor(GuiGetStyle(LISTVIEW, BORDER_COLOR_DISABLED)), GetColor(GuiGetStyle(LISTVIEW, BASE_COLOR_DISABLED)));
 
-            GuiDrawText(text[startIndex + i], GetTextBounds(DEFAULT, itemBounds), GuiGetStyle(LISTVIEW, TEXT_ALIGNMENT), GetColor(GuiGetStyle(LISTVIEW, TEXT_COLOR_DISABLED)));
+            GuiDrawText(itemText, GetTextBounds(DEFAULT, itemBounds), GuiGetStyle(LISTVIEW, TEXT_ALIGNMENT), GetColor(GuiGetStyle(LISTVIEW, TEXT_COLOR_DISABLED)));
         }
         else
         {
@@ -3483,18 +3595,18 @@ int GuiListViewEx(Rectangle bounds, const char **text, int count, int *scrollInd
             {
                 // Draw item selected
                 GuiDrawRectangle(itemBounds, GuiGetStyle(LISTVIEW, BORDER_WIDTH), GetColor(GuiGetStyle(LISTVIEW, BORDER_COLOR_PRESSED)), GetColor(GuiGetStyle(LISTVIEW, BASE_COLOR_PRESSED)));
-                GuiDrawText(text[startIndex + i], GetTextBounds(DEFAULT, itemBounds), GuiGetStyle(LISTVIEW, TEXT_ALIGNMENT), GetColor(GuiGetStyle(LISTVIEW, TEXT_COLOR_PRESSED)));
+                GuiDrawText(itemText, GetTextBounds(DEFAULT, itemBounds), GuiGetStyle(LISTVIEW, TEXT_ALIGNMENT), GetColor(GuiGetStyle(LISTVIEW, TEXT_COLOR_PRESSED)));
             }
             else if (((startIndex + i) == itemFocused)) // && (focus != NULL))  // NOTE: We want items focused, despite not returned!
             {
                 // Draw item focused
                 GuiDrawRectangle(itemBounds, GuiGetStyle(LISTVIEW, BORDER_WIDTH), GetColor(GuiGetStyle(LISTVIEW, BORDER_COLOR_FOCUSED)), GetColor(GuiGetStyle(LISTVIEW, BASE_COLOR_FOCUSED)));
-                GuiDrawText(text[startIndex + i], GetTextBounds(DEFAULT, itemBounds), GuiGetStyle(LISTVIEW, TEXT_ALIGNMENT), GetColor(GuiGetStyle(LISTVIEW, TEXT_COLOR_FOCUSED)));
+                GuiDrawText(itemText, GetTextBounds(DEFAULT, itemBounds), GuiGetStyle(LISTVIEW, TEXT_ALIGNMENT), GetColor(GuiGetStyle(LISTVIEW, TEXT_COLOR_FOCUSED)));
             }
             else
             {
                 // Draw item normal
-                GuiDrawText(text[startIndex + i], GetTextBounds(DEFAULT, itemBounds), GuiGetStyle(LISTVIEW, TEXT_ALIGNMENT), GetColor(GuiGetStyle(LISTVIEW, TEXT_COLOR_NORMAL)));
+                GuiDrawText(itemText, GetTextBounds(DEFAULT, itemBounds), GuiGetStyle(LISTVIEW, TEXT_ALIGNMENT), GetColor(GuiGetStyle(LISTVIEW, TEXT_COLOR_NORMAL)));
             }
         }
 
@@ -4331,6 +4443,8 @@ void GuiLoadStyleDefault(void)
 
         // Setup default raylib font
         guiFont = GetFontDefault();
+        ClearTextWidthCache();
+        LoadGlyphTable();
 
         // NOTE: Default raylib font character 95 is a white square
         Rectangle whiteChar = guiFont.recs[95];
@@ -4375,7 +4489,14 @@ const char *GuiIconText(int iconId, const char *text)
 
 #if !defined(RAYGUI_NO_ICONS)
 // Get full icons data pointer
-unsigned int *GuiGetIcons(void) { return guiIconsPtr; }
+// NOTE: Icons data could be modified through the pointer, atlas is rebuilt on next draw
+unsigned int *GuiGetIcons(void)
+{
+#if !defined(RAYGUI_STANDALONE)
+    guiIconsTextureDirty = true;
+#endif
+    return guiIconsPtr;
+}
 
 // Load raygui icons file (.rgi)
 // NOTE: In case nameIds are required, they can be requested with loadIconsName,
@@ -4443,6 +4564,9 @@ char **GuiLoadIcons(const char *fileName, bool loadIconsName)
 
             // Read icons data directly over internal icons array
             fread(guiIconsPtr, sizeof(unsigned int), iconCount*(iconSize*iconSize/32), rgiFile);
+        #if !defined(RAYGUI_STANDALONE)
+            guiIconsTextureDirty = true;
+        #endif
         }
 
         fclose(rgiFile);
@@ -4451,25 +4575,74 @@ char **GuiLoadIcons(const char *fileName, bool loadIconsName)
     return guiIconsName;
 }
 
-// Draw selected icon using rectangles pixel-by-pixel
-void GuiDrawIcon(int iconId, int posX, int posY, int pixelSize, Color color)
+#if !defined(RAYGUI_STANDALONE)
+// Rasterize icons data into atlas texture, white pixels with alpha
+static void GuiLoadIconsTexture(void)
 {
-    #define BIT_CHECK(a,b) ((a) & (1u<<(b)))
-
-    for (int i = 0, y = 0; i < RAYGUI_ICON_SIZE*RAYGUI_ICON_SIZE/32; i++)
+    int rows = (RAYGUI_ICON_MAX_ICONS + RAYGUI_ICONS_ATLAS_COLUMNS - 1)/RAYGUI_ICONS_ATLAS_COLUMNS;
+    Image image = { 0 };
+    image.width = RAYGUI_ICONS_ATLAS_COLUMNS*RAYGUI_ICON_SIZE;
+    image.height = rows*RAYGUI_ICON_SIZE;
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    image.data = RAYGUI_CALLOC(image.width*image.height, 4*sizeof(unsigned char));
+
+    unsigned char *pixels = (unsigned char *)image.data;
+    for (int iconId = 0; iconId < RAYGUI_ICON_MAX_ICONS; iconId++)
     {
-        for (int k = 0; k < 32; k++)
+        int iconX = (iconId%RAYGUI_ICONS_ATLAS_COLUMNS)*RAYGUI_ICON_SIZE;
+        int iconY = (iconId/RAYGUI_ICONS_ATLAS_COLUMNS)*RAYGUI_ICON_SIZE;
+
+        for (int p = 0; p < RAYGUI_ICON_SIZE*RAYGUI_ICON_SIZE; p++)
         {
-            if (BIT_CHECK(guiIconsPtr[iconId*RAYGUI_ICON_DATA_ELEMENTS + i], k))
+            if (guiIconsPtr[iconId*RAYGUI_ICON_DATA_ELEMENTS + p/32] & (1u << (p%32)))
             {
-            #if !defined(RAYGUI_STANDALONE)
-                GuiDrawRectangle(RAYGUI_CLITERAL(Rectangle){ (float)posX + (k%RAYGUI_ICON_SIZE)*pixelSize, (float)posY + y*pixelSize, (float)pixelSize, (float)pixelSize }, 0, BLANK, color);
-            #endif
+                unsigned char *pixel = &pixels[4*((iconY + p/RAYGUI_ICON_SIZE)*image.width + iconX + p%RAYGUI_ICON_SIZE)];
+                pixel[0] = pixel[1] = pixel[2] = pixel[3] = 255;
             }
-
-            if ((k == 15) || (k == 31)) y++;
         }
     }
+
+    if ((guiIconsTexture.id > 0) && (guiIconsTexture.width == image.width) && (guiIconsTexture.height == image.height)) UpdateTexture(guiIconsTexture, image.data);
+    else
+    {
+        if (guiIconsTexture.id > 0) UnloadTexture(guiIconsTexture);
+        guiIconsTexture = LoadTextureFromImage(image);
+
+        // NOTE: Point filtering keeps icon pixels sharp at any icon scale
+        SetTextureFilter(guiIconsTexture, TEXTURE_FILTER_POINT);
+    }
+
+    RAYGUI_FREE(image.data);
+    guiIconsTextureDirty = false;
+}
+#endif
+
+// Draw selected icon as one quad of the icons atlas texture
+void GuiDrawIcon(int iconId, int posX, int posY, int pixelSize, Color color)
+{
+#if !defined(RAYGUI_STANDALONE)
+    if ((iconId < 0) || (iconId >= RAYGUI_ICON_MAX_ICONS)) return;
+
+    if (guiIconsTextureDirty || (guiIconsTexture.id == 0)) GuiLoadIconsTexture();
+
+    Rectangle source = { (float)((iconId%RAYGUI_ICONS_ATLAS_COLUMNS)*RAYGUI_ICON_SIZE), (float)((iconId/RAYGUI_ICONS_ATLAS_COLUMNS)*RAYGUI_ICON_SIZE),
+                         (float)RAYGUI_ICON_SIZE, (float)RAYGUI_ICON_SIZE };
+    Rectangle dest = { (float)posX, (float)posY, (float)RAYGUI_ICON_SIZE*pixelSize, (float)RAYGUI_ICON_SIZE*pixelSize };
+
+    DrawTexturePro(guiIconsTexture, source, dest, RAYGUI_CLITERAL(Vector2){ 0, 0 }, 0.0f, GuiFade(color, guiAlpha));
+#endif
+}
+
+// Unload icons atlas texture
+// NOTE: Requires the graphics context, next GuiDrawIcon() creates the atlas again
+void GuiUnloadIcons(void)
+{
+#if !defined(RAYGUI_STANDALONE)
+    if (guiIconsTexture.id > 0) UnloadTexture(guiIconsTexture);
+    guiIconsTexture = RAYGUI_CLITERAL(Texture2D){ 0 };
+    guiIconsTextureDirty = true;
+#endif
 }
 
 // Set icon drawing size
@@ -4749,16 +4922,39 @@ static int GetTextWidth(const char *text)
             float scaleFactor = fontSize/(float)guiFont.baseSize;
             textSize.y = (float)guiFont.baseSize*scaleFactor;
             float glyphWidth = 0.0f;
+            int spacing = GuiGetStyle(DEFAULT, TEXT_SPACING);
+
+            // Look for a previous measurement of the same line, FNV-1a hash
+            unsigned long long hash = 14695981039346656037ULL;
+            for (int i = 0; i < size; i++) hash = (hash ^ (unsigned char)text[i])*1099511628211ULL;
 
-            for (int i = 0, codepointSize = 0; i < size; i += codepointSize)
+            GuiTextWidthEntry *entry = &guiTextWidthCache[(hash ^ (hash >> 32)) & (RAYGUI_TEXT_WIDTH_CACHE_SIZE - 1)];
+
+            if (entry->valid && (entry->hash == hash) && (entry->length == size) &&
+                (entry->fontId == guiFont.texture.id) && (entry->fontSize == (int)fontSize) && (entry->spacing == spacing))
+            {
+                textSize.x = entry->width;
+            }
+            else
             {
-                int codepoint = GetCodepointNext(&text[i], &codepointSize);
-                int codepointIndex = GetGlyphIndex(guiFont, codepoint);
+                for (int i = 0, codepointSize = 0; i < size; i += codepointSize)
+                {
+                    int codepoint = GetCodepointNext(&text[i], &codepointSize);
+                    int codepointIndex = GetGuiGlyphIndex(codepoint);
+
+                    if (guiFont.glyphs[codepointIndex].advanceX == 0) glyphWidth = ((float)guiFont.recs[codepointIndex].width*scaleFactor);
+                    else glyphWidth = ((float)guiFont.glyphs[codepointIndex].advanceX*scaleFactor);
 
-                if (guiFont.glyphs[codepointIndex].advanceX == 0) glyphWidth = ((float)guiFont.recs[codepointIndex].width*scaleFactor);
-                else glyphWidth = ((float)guiFont.glyphs[codepointIndex].advanceX*scaleFactor);
+                    textSize.x += (glyphWidth + (float)spacing);
+                }
 
-                textSize.x += (glyphWidth + (float)GuiGetStyle(DEFAULT, TEXT_SPACING));
+                entry->valid = true;
+                entry->hash = hash;
+                entry->length = size;
+                entry->fontId = guiFont.texture.id;
+                entry->fontSize = (int)fontSize;
+                entry->spacing = spacing;
+                entry->width = textSize.x;
             }
         }
 
@@ -4768,6 +4964,88 @@ static int GetTextWidth(const char *text)
     return (int)textSize.x;
 }
 
+// Forget all measured text widths
+static void ClearTextWidthCache(void)
+{
+    for (int i = 0; i < RAYGUI_TEXT_WIDTH_CACHE_SIZE; i++) guiTextWidthCache[i].valid = false;
+}
+
+// Build codepoint to glyph index table for current gui font
+// NOTE: Lookups give the same result as GetGlyphIndex(): first glyph with the codepoint,
+// otherwise the '?' glyph, otherwise glyph 0
+static void LoadGlyphTable(void)
+{
+    RAYGUI_FREE(guiGlyphTable);
+    guiGlyphTable = NULL;
+    guiGlyphFallback = 0;
+    for (int i = 0; i < RAYGUI_GLYPH_PAGE_COUNT; i++) guiGlyphPages[i] = -1;
+
+    if ((guiFont.glyphs == NULL) || (guiFont.glyphCount <= 0)) return;
+
+    // Assign table offsets to pages holding glyphs
+    int pageCount = 0;
+    for (int i = 0; i < guiFont.glyphCount; i++)
+    {
+        int codepoint = guiFont.glyphs[i].value;
+        if (codepoint == 63) guiGlyphFallback = i;
+
+        if ((codepoint >= 0) && (codepoint < RAYGUI_GLYPH_PAGE_COUNT*RAYGUI_GLYPH_PAGE_SIZE) &&
+            (guiGlyphPages[codepoint/RAYGUI_GLYPH_PAGE_SIZE] < 0))
+        {
+            guiGlyphPages[codepoint/RAYGUI_GLYPH_PAGE_SIZE] = (pageCount++)*RAYGUI_GLYPH_PAGE_SIZE;
+        }
+    }
+
+    // NOTE: Without a table (allocation failed) lookups fall back to GetGlyphIndex()
+    guiGlyphTable = (int *)RAYGUI_MALLOC(pageCount*RAYGUI_GLYPH_PAGE_SIZE*sizeof(int));
+    if (guiGlyphTable == NULL) return;
+
+    for (int i = 0; i < pageCount*RAYGUI_GLYPH_PAGE_SIZE; i++) guiGlyphTable[i] = -1;
+
+    for (int i = 0; i < guiFont.glyphCount; i++)
+    {
+        int codepoint = guiFont.glyphs[i].value;
+        if ((codepoint < 0) || (codepoint >= RAYGUI_GLYPH_PAGE_COUNT*RAYGUI_GLYPH_PAGE_SIZE)) continue;
+
+        int *slot = &guiGlyphTable[guiGlyphPages[codepoint/RAYGUI_GLYPH_PAGE_SIZE] + codepoint%RAYGUI_GLYPH_PAGE_SIZE];
+        if (*slot < 0) *slot = i;
+    }
+
+    for (int i = 0; i < pageCount*RAYGUI_GLYPH_PAGE_SIZE; i++)
+    {
+        if (guiGlyphTable[i] < 0) guiGlyphTable[i] = guiGlyphFallback;
+    }
+}
+
+// Get gui font glyph index for a codepoint, using glyph table
+static int GetGuiGlyphIndex(int codepoint)
+{
+    // No table, its allocation failed
+    if (guiGlyphTable == NULL) return GetGlyphIndex(guiFont, codepoint);
+
+    if ((codepoint < 0) || (codepoint >= RAYGUI_GLYPH_PAGE_COUNT*RAYGUI_GLYPH_PAGE_SIZE)) return guiGlyphFallback;
+
+    int page = guiGlyphPages[codepoint/RAYGUI_GLYPH_PAGE_SIZE];
+    return (page < 0)? guiGlyphFallback : guiGlyphTable[page + codepoint%RAYGUI_GLYPH_PAGE_SIZE];
+}
+
+// Draw gui font glyph by index
+// NOTE: Same as raylib DrawTextCodepoint() without the glyph search
+static void GuiDrawGlyph(int index, Vector2 position, float fontSize, Color tint)
+{
+    float scaleFactor = fontSize/guiFont.baseSize;
+    float padding = (float)guiFont.glyphPadding;
+
+    Rectangle dstRec = { position.x + guiFont.glyphs[index].offsetX*scaleFactor - padding*scaleFactor,
+                         position.y + guiFont.glyphs[index].offsetY*scaleFactor - padding*scaleFactor,
+                         (guiFont.recs[index].width + 2.0f*padding)*scaleFactor,
+                         (guiFont.recs[index].height + 2.0f*padding)*scaleFactor };
+    Rectangle srcRec = { guiFont.recs[index].x - padding, guiFont.recs[index].y - padding,
+                         guiFont.recs[index].width + 2.0f*padding, guiFont.recs[index].height + 2.0f*padding };
+
+    DrawTexturePro(guiFont.texture, srcRec, dstRec, RAYGUI_CLITERAL(Vector2){ 0, 0 }, 0.0f, tint);
+}
+
 // Get text bounds considering control bounds
 static Rectangle GetTextBounds(int control, Rectangle bounds)
 {
@@ -4836,32 +5114,32 @@ static const char *GetTextIcon(const char *text, int *iconId)
 // Get text divided into lines (by line-breaks '\n')
 const char **GetTextLines(const char *text, int *count)
 {
-    #define RAYGUI_MAX_TEXT_LINES   128
+    // NOTE: Lines point into text, only the lines array is kept between calls and grows as needed
+    static const char **lines = NULL;
+    static int linesCapacity = 0;
 
-    static const char *lines[RAYGUI_MAX_TEXT_LINES] = { 0 };
-    for (int i = 0; i < RAYGUI_MAX_TEXT_LINES; i++) lines[i] = NULL;    // Init NULL pointers to substrings
+    int lineCount = 1;
+    for (int i = 0; text[i] != '\0'; i++) if (text[i] == '\n') lineCount++;
 
-    int textSize = (int)strlen(text);
+    const char **newLines = (const char **)GuiReserve((void *)lines, &linesCapacity, (size_t)lineCount*sizeof(const char *));
+    if (newLines == NULL)
+    {
+        *count = 0;
+        return lines;
+    }
+    lines = newLines;
 
     lines[0] = text;
-    int len = 0;
-    *count = 1;
-    //int lineSize = 0;   // Stores current line size, not returned
-
-    for (int i = 0, k = 0; (i < textSize) && (*count < RAYGUI_MAX_TEXT_LINES); i++)
+    for (int i = 0, k = 1; text[i] != '\0'; i++)
     {
         if (text[i] == '\n')
         {
-            //lineSize = len;
+            lines[k] = &text[i + 1];
             k++;
-            lines[k] = &text[i + 1];     // WARNING: next value is valid?
-            len = 0;
-            *count += 1;
         }
-        else len++;
     }
 
-    //lines[*count - 1].size = len;
+    *count = lineCount;
 
     return lines;
 }
@@ -4881,7 +5159,7 @@ static float GetNextSpaceWidth(const char *text, int *nextSpaceIndex)
         if (text[i] != ' ')
         {
             codepoint = GetCodepoint(&text[i], &codepointByteCount);
-            index = GetGlyphIndex(guiFont, codepoint);
+            index = GetGuiGlyphIndex(codepoint);
             glyphWidth = (guiFont.glyphs[index].advanceX == 0)? guiFont.recs[index].width*scaleFactor : guiFont.glyphs[index].advanceX*scaleFactor;
             width += (glyphWidth + (float)GuiGetStyle(DEFAULT, TEXT_SPACING));
         }
@@ -5007,7 +5285,7 @@ static void GuiDrawText(const char *text, Rectangle textBounds, int alignment, C
         for (int c = 0, codepointSize = 0; c < lineSize; c += codepointSize)
         {
             int codepoint = GetCodepointNext(&lines[i][c], &codepointSize);
-            int index = GetGlyphIndex(guiFont, codepoint);
+            int index = GetGuiGlyphIndex(codepoint);
 
             // NOTE: Normally we exit the decoding sequence as soon as a bad byte is found (and return 0x3f)
             // but we need to draw all of the bad bytes using the '?' symbol moving one byte
@@ -5072,21 +5350,22 @@ static void GuiDrawText(const char *text, Rectangle textBounds, int alignment, C
                         {
                             if (textOffsetX <= (textBounds.width - glyphWidth - textBoundsWidthOffset - ellipsisWidth))
                             {
-                                DrawTextCodepoint(guiFont, codepoint, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
+                                GuiDrawGlyph(index, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
                             }
                             else if (!textOverflow)
                             {
                                 textOverflow = true;
 
+                                int dotIndex = GetGuiGlyphIndex('.');
                                 for (int j = 0; j < ellipsisWidth; j += ellipsisWidth/3)
                                 {
-                                    DrawTextCodepoint(guiFont, '.', RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX + j, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
+                                    GuiDrawGlyph(dotIndex, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX + j, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
                                 }
                             }
                         }
                         else
                         {
-                            DrawTextCodepoint(guiFont, codepoint, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
+                            GuiDrawGlyph(index, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
                         }
                     }
                     else if ((wrapMode == TEXT_WRAP_CHAR) || (wrapMode == TEXT_WRAP_WORD))
@@ -5094,7 +5373,7 @@ static void GuiDrawText(const char *text, Rectangle textBounds, int alignment, C
                         // Draw only glyphs inside the bounds
                         if ((textBoundsPosition.y + textOffsetY) <= (textBounds.y + textBounds.height - GuiGetStyle(DEFAULT, TEXT_SIZE)))
                         {
-                            DrawTextCodepoint(guiFont, codepoint, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
+                            GuiDrawGlyph(index, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
                         }
                     }
                 }
@@ -5160,59 +5439,116 @@ static void GuiTooltip(Rectangle controlRec)
 
 // Split controls text into multiple strings
 // Also check for multiple columns (required by GuiToggleGroup())
-static const char **GuiTextSplit(const char *text, char delimiter, int *count, int *textRow)
+static const char **GuiTextSplit(const char *text, char delimiter, int *count, const int **textRows)
 {
-    // NOTE: Current implementation returns a copy of the provided string with '\0' (string end delimiter)
-    // inserted between strings defined by "delimiter" parameter. No memory is dynamically allocated,
-    // all used memory is static... it has some limitations:
-    //      1. Maximum number of possible split strings is set by RAYGUI_TEXTSPLIT_MAX_ITEMS
-    //      2. Maximum size of text to split is RAYGUI_TEXTSPLIT_MAX_TEXT_SIZE
-    // NOTE: Those definitions could be externally provided if required
-
-    // TODO: HACK: GuiTextSplit() - Review how textRows are returned to user
-    // textRow is an externally provided array of integers that stores row number for every splitted string
-
-    #if !defined(RAYGUI_TEXTSPLIT_MAX_ITEMS)
-        #define RAYGUI_TEXTSPLIT_MAX_ITEMS          128
-    #endif
-    #if !defined(RAYGUI_TEXTSPLIT_MAX_TEXT_SIZE)
-        #define RAYGUI_TEXTSPLIT_MAX_TEXT_SIZE     1024
-    #endif
+    // NOTE: Returns items of a copy of the provided string with '\0' (string end delimiter)
+    // inserted between strings defined by "delimiter" parameter, '\n' also separates items
+    // and starts a new row. Results are cached per text pointer and delimiter, returned
+    // pointers stay valid until RAYGUI_TEXTSPLIT_CACHE_SIZE other texts have been split,
+    // or until the same text pointer is split again with different contents
+    if (text == NULL) text = "";
+
+    // Text length, hash and items count in a single pass
+    unsigned long long hash = 14695981039346656037ULL;
+    int length = 0;
+    int itemCount = 1;
+    for (; text[length] != '\0'; length++)
+    {
+        hash = (hash ^ (unsigned char)text[length])*1099511628211ULL;
+        if ((text[length] == delimiter) || (text[length] == '\n')) itemCount++;
+    }
 
-    static const char *result[RAYGUI_TEXTSPLIT_MAX_ITEMS] = { NULL };   // String pointers array (points to buffer data)
-    static char buffer[RAYGUI_TEXTSPLIT_MAX_TEXT_SIZE] = { 0 };         // Buffer data (text input copy with '\0' added)
-    memset(buffer, 0, RAYGUI_TEXTSPLIT_MAX_TEXT_SIZE);
+    // Look for the text in cache, otherwise replace the least recently used entry
+    GuiTextSplitEntry *entry = NULL;
+    GuiTextSplitEntry *oldest = &guiTextSplitCache[0];
+    for (int i = 0; i < RAYGUI_TEXTSPLIT_CACHE_SIZE; i++)
+    {
+        if ((guiTextSplitCache[i].source == text) && (guiTextSplitCache[i].delimiter == delimiter))
+        {
+            entry = &guiTextSplitCache[i];
+            break;
+        }
 
-    result[0] = buffer;
-    int counter = 1;
+        if (guiTextSplitCache[i].lastUse < oldest->lastUse) oldest = &guiTextSplitCache[i];
+    }
 
-    if (textRow != NULL) textRow[0] = 0;
+    if (entry == NULL) entry = oldest;
+    guiTextSplitCounter++;
 
-    // Count how many substrings we have on text and point to every one
-    for (int i = 0; i < RAYGUI_TEXTSPLIT_MAX_TEXT_SIZE; i++)
+    if ((entry->source != text) || (entry->delimiter != delimiter) || (entry->hash != hash) || (entry->length != length))
     {
-        buffer[i] = text[i];
-        if (buffer[i] == '\0') break;
-        else if ((buffer[i] == delimiter) || (buffer[i] == '\n'))
+        entry->source = text;
+        entry->delimiter = delimiter;
+        entry->hash = hash;
+        entry->length = length;
+        entry->count = itemCount;
+
+        // NOTE: Every buffer that did grow is kept, on any failure the entry is
+        // invalidated and an empty split is returned
+        char *buffer = (char *)GuiReserve(entry->buffer, &entry->bufferCapacity, (size_t)length + 1);
+        if (buffer != NULL) entry->buffer = buffer;
+        const char **items = (const char **)GuiReserve((void *)entry->items, &entry->itemsCapacity, (size_t)itemCount*sizeof(const char *));
+        if (items != NULL) entry->items = items;
+        int *rows = (int *)GuiReserve(entry->rows, &entry->rowsCapacity, (size_t)itemCount*sizeof(int));
+        if (rows != NULL) entry->rows = rows;
+
+        if ((buffer == NULL) || (items == NULL) || (rows == NULL))
         {
-            result[counter] = buffer + i + 1;
+            static const char *emptyItems[1] = { "" };
+            static const int emptyRows[1] = { 0 };
 
-            if (textRow != NULL)
-            {
-                if (buffer[i] == '\n') textRow[counter] = textRow[counter - 1] + 1;
-                else textRow[counter] = textRow[counter - 1];
-            }
+            entry->source = NULL;
+            entry->count = 0;
 
-            buffer[i] = '\0';   // Set an end of string at this point
+            *count = 0;
+            if (textRows != NULL) *textRows = emptyRows;
 
-            counter++;
-            if (counter > RAYGUI_TEXTSPLIT_MAX_ITEMS) break;
+            return emptyItems;
+        }
+
+        memcpy(entry->buffer, text, length + 1);
+        entry->items[0] = entry->buffer;
+        entry->rows[0] = 0;
+
+        // Point to every substring and set an end of string at every delimiter
+        for (int i = 0, k = 1; i < length; i++)
+        {
+            if ((entry->buffer[i] == delimiter) || (entry->buffer[i] == '\n'))
+            {
+                entry->items[k] = entry->buffer + i + 1;
+                entry->rows[k] = (entry->buffer[i] == '\n')? entry->rows[k - 1] + 1 : entry->rows[k - 1];
+                entry->buffer[i] = '\0';
+                k++;
+            }
         }
     }
 
-    *count = counter;
+    entry->lastUse = guiTextSplitCounter;
 
-    return result;
+    *count = entry->count;
+    if (textRows != NULL) *textRows = entry->rows;
+
+    return entry->items;
+}
+
+// Grow buffer to at least size bytes, keeps contents
+// NOTE: Capacity doubles, so buffers reused every frame stop allocating after a few calls
+// WARNING: On failure NULL is returned and buffer and capacity are left untouched,
+// callers must keep their old pointer until the new one is known to be valid
+// NOTE: Capacity is computed in size_t, sizes over INT_MAX bytes fail
+static void *GuiReserve(void *buffer, int *capacity, size_t size)
+{
+    if (size <= (size_t)*capacity) return buffer;
+    if (size > INT_MAX) return NULL;
+
+    size_t newCapacity = (*capacity > 0)? (size_t)*capacity : 64;
+    while (newCapacity < size) newCapacity *= 2;
+    if (newCapacity > INT_MAX) newCapacity = INT_MAX;
+
+    void *newBuffer = RAYGUI_REALLOC(buffer, newCapacity);
+    if (newBuffer != NULL) *capacity = (int)newCapacity;
+
+    return newBuffer;
 }
 
 // Convert color data from RGB to HSV
@@ -5339,6 +5675,12 @@ static Vector3 ConvertHSVtoRGB(Vector3 hsv)
     return rgb;
 }
 
+// List view item provider over a text array
+static const char *GetListItemText(int index, void *userData)
+{
+    return ((const char **)userData)[index];
+}
+
 // Scroll bar control (used by GuiScrollPanel())
 static int GuiScrollBar(Rectangle bounds, int value, int minValue, int maxValue)
 {
@@ -5554,17 +5896,25 @@ static bool CheckCollisionPointRec(Vector2 point, Rectangle rec)
 }
 
 // Formatting of text with variables to 'embed'
+// NOTE: Buffer grows to the formatted size, text is never truncated
 static const char *TextFormat(const char *text, ...)
 {
-    #if !defined(RAYGUI_TEXTFORMAT_MAX_SIZE)
-        #define RAYGUI_TEXTFORMAT_MAX_SIZE   256
-    #endif
-
-    static char buffer[RAYGUI_TEXTFORMAT_MAX_SIZE];
+    static char *buffer = NULL;
+    static int bufferCapacity = 0;
 
     va_list args;
     va_start(args, text);
-    vsprintf(buffer, text, args);
+    int size = vsnprintf(NULL, 0, text, args);
+    va_end(args);
+
+    if (size < 0) return "";
+
+    char *newBuffer = (char *)GuiReserve(buffer, &bufferCapacity, (size_t)size + 1);
+    if (newBuffer == NULL) return "";
+    buffer = newBuffer;
+
+    va_start(args, text);
+    vsnprintf(buffer, size + 1, text, args);
     va_end(args);
 
     return buffer;
@@ -0,0 +1,144 @@
+#include "bench.h"
+
+#include <algorithm>  // Required for: std::max(), std::min()
+#include <cstdio>
+#include <cstdlib>  // Required for: strtod()
+#include <cstring>  // Required for: strncmp(), strstr()
+#include <memory>
+
+namespace bench {
+
+static std::vector<std::unique_ptr<Benchmark> > &registry() {
+  static std::vector<std::unique_ptr<Benchmark> > benchmarks;
+  return benchmarks;
+}
+
+Benchmark *registerBenchmark(const char *name, Function function) {
+  registry().emplace_back(new Benchmark(name, function));
+  return registry().back().get();
+}
+
+Benchmark *Benchmark::args(const std::vector<long> &args) {
+  argSets_.push_back(args);
+  return this;
+}
+
+Benchmark *Benchmark::rangeMultiplier(int multiplier) {
+  multiplier_ = multiplier;
+  return this;
+}
+
+Benchmark *Benchmark::ranges(
+    const std::vector<std::pair<long, long> > &ranges) {
+  std::vector<std::vector<long> > values(ranges.size());
+  for (size_t i = 0; i < ranges.size(); i++) {
+    for (long v = ranges[i].first; v < ranges[i].second; v *= multiplier_) {
+      values[i].push_back(v);
+    }
+    values[i].push_back(ranges[i].second);
+  }
+
+  // odometer over the value lists, last dimension fastest
+  std::vector<size_t> index(ranges.size(), 0);
+  while (true) {
+    std::vector<long> args(ranges.size());
+    for (size_t i = 0; i < ranges.size(); i++) args[i] = values[i][index[i]];
+    argSets_.push_back(args);
+
+    size_t i = ranges.size();
+    while (i > 0 && ++index[i - 1] == values[i - 1].size()) index[--i] = 0;
+    if (i == 0) break;
+  }
+  return this;
+}
+
+static std::string runName(const Benchmark &benchmark,
+                           const std::vector<long> &args) {
+  std::string name = benchmark.name();
+  for (long arg : args) name += "/" + std::to_string(arg);
+  return name;
+}
+
+static void formatTime(double seconds, char *text, size_t size) {
+  if (seconds < 1e-6) {
+    snprintf(text, size, "%.1f ns", seconds * 1e9);
+  } else if (seconds < 1e-3) {
+    snprintf(text, size, "%.2f us", seconds * 1e6);
+  } else if (seconds < 1) {
+    snprintf(text, size, "%.2f ms", seconds * 1e3);
+  } else {
+    snprintf(text, size, "%.2f s", seconds);
+  }
+}
+
+// Grow the iteration count until one run takes minTime, like Google
+// Benchmark: at most 10x per step, aiming 40% past the target
+static State runBenchmark(const Benchmark &benchmark,
+                          const std::vector<long> &args, double minTime) {
+  int64_t iterations = 1;
+  while (true) {
+    State state(args, iterations);
+    benchmark.function()(state);
+    if (!state.skipped().empty() || state.elapsed() >= minTime ||
+        iterations >= ((int64_t)1 << 30)) {
+      return state;
+    }
+    double factor = state.elapsed() > 0 ? 1.4 * minTime / state.elapsed() : 10;
+    factor = std::min(std::max(factor, 2.0), 10.0);
+    iterations = (int64_t)(iterations * factor);
+  }
+}
+
+}  // namespace bench
+
+int main(int argc, char **argv) {
+  double minTime = 0.2;
+  const char *filter = "";
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--min_time=", 11) == 0) {
+      minTime = strtod(argv[i] + 11, nullptr);
+    } else if (strncmp(argv[i], "--filter=", 9) == 0) {
+      filter = argv[i] + 9;
+    } else {
+      printf("Usage: %s [--filter=<substring>] [--min_time=<seconds>]\n",
+             argv[0]);
+      return 2;
+    }
+  }
+
+#if !defined(__OPTIMIZE__) && !defined(NDEBUG)
+  printf("WARNING: built without optimizations, timings are meaningless\n");
+#endif
+  printf("%-32s %12s %12s %12s %10s\n", "Benchmark", "Time", "Iterations",
+         "ns/point", "GFLOP/s");
+  printf("%s\n", std::string(82, '-').c_str());
+  for (const auto &benchmark : bench::registry()) {
+    for (const std::vector<long> &args : benchmark->argSets()) {
+      std::string name = bench::runName(*benchmark, args);
+      if (!strstr(name.c_str(), filter)) continue;
+
+      bench::State state = bench::runBenchmark(*benchmark, args, minTime);
+      if (!state.skipped().empty()) {
+        printf("%-32s skipped: %s\n", name.c_str(), state.skipped().c_str());
+        continue;
+      }
+      double perIteration = state.elapsed() / state.iterations();
+      char time[32];
+      bench::formatTime(perIteration, time, sizeof(time));
+      printf("%-32s %12s %12lld", name.c_str(), time,
+             (long long)state.iterations());
+      if (state.points() > 0) {
+        printf(" %12.2f", perIteration * 1e9 / state.points());
+      } else {
+        printf(" %12s", "-");
+      }
+      if (state.flops() > 0) {
+        printf(" %10.2f\n", state.flops() / perIteration * 1e-9);
+      } else {
+        printf(" %10s\n", "-");
+      }
+      fflush(stdout);
+    }
+  }
+  return 0;
+}
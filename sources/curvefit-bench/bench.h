@@ -0,0 +1,109 @@
+// Minimal micro-benchmark harness in the style of Google Benchmark
+//
+//   static void BM_Foo(bench::State &state) {
+//     ... setup, not timed ...
+//     while (state.keepRunning()) bench::doNotOptimize(foo(state.range(0)));
+//     state.setPointsProcessed(state.range(0));
+//     state.setFlops(2.0 * state.range(0));
+//   }
+//   BENCHMARK(BM_Foo)->ranges({{10, 100000}});
+//
+// Each benchmark runs with a doubling iteration count until it takes at
+// least --min_time seconds, then reports time per iteration, ns per point
+// and GFLOP/s.
+#ifndef CURVEFIT_BENCH_H
+#define CURVEFIT_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+class State {
+ public:
+  State(const std::vector<long> &args, int64_t iterations)
+      : args_(args), iterations_(iterations) {}
+
+  // True while iterations remain, times the loop body
+  bool keepRunning() {
+    if (remaining_ == iterations_) start_ = Clock::now();
+    if (remaining_-- > 0) return true;
+    elapsed_ = std::chrono::duration<double>(Clock::now() - start_).count();
+    return false;
+  }
+
+  long range(size_t i) const { return args_[i]; }
+  int64_t iterations() const { return iterations_; }
+  double elapsed() const { return elapsed_; }
+
+  // Work done by one iteration
+  void setPointsProcessed(double points) { points_ = points; }
+  void setFlops(double flops) { flops_ = flops; }
+  double points() const { return points_; }
+  double flops() const { return flops_; }
+
+  // Report the benchmark as skipped, e.g. for a size it cannot handle
+  void skip(const char *reason) { skipped_ = reason; }
+  const std::string &skipped() const { return skipped_; }
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  std::vector<long> args_;
+  int64_t iterations_;
+  int64_t remaining_ = iterations_;
+  Clock::time_point start_;
+  double elapsed_ = 0;
+  double points_ = 0, flops_ = 0;
+  std::string skipped_;
+};
+
+typedef void (*Function)(State &);
+
+class Benchmark {
+ public:
+  Benchmark(const char *name, Function function)
+      : name_(name), function_(function) {}
+
+  // One run per argument list
+  Benchmark *args(const std::vector<long> &args);
+  // Cartesian product of the powers of multiplier in each [lo, hi] range,
+  // both ends included
+  Benchmark *ranges(const std::vector<std::pair<long, long> > &ranges);
+  Benchmark *rangeMultiplier(int multiplier);
+
+  const std::string &name() const { return name_; }
+  Function function() const { return function_; }
+  const std::vector<std::vector<long> > &argSets() const { return argSets_; }
+
+ private:
+  std::string name_;
+  Function function_;
+  int multiplier_ = 10;
+  std::vector<std::vector<long> > argSets_;
+};
+
+Benchmark *registerBenchmark(const char *name, Function function);
+
+// Keep the compiler from discarding a computed value
+template <class T>
+inline void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile char sink;
+  sink = *(const volatile char *)&value;
+#endif
+}
+
+}  // namespace bench
+
+#define BENCHMARK_CONCAT2(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT2(a, b)
+#define BENCHMARK(function)                                   \
+  static bench::Benchmark *BENCHMARK_CONCAT(benchmark_, __LINE__) = \
+      bench::registerBenchmark(#function, function)
+
+#endif  // CURVEFIT_BENCH_H
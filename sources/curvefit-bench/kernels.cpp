@@ -0,0 +1,242 @@
+// Benchmarks of the curvefit kernels
+//
+// Arguments are {n, order}: n points on a noisy sine, order basis functions.
+// Flop counts are the usual textbook leading terms, good for comparing runs
+// rather than as exact hardware numbers.
+#include <cmath>  // Required for: sin()
+
+#include "bench.h"
+#include "compact_rbf.h"
+#include "curvefit.h"
+#include "spline.h"
+
+using Eigen::ArrayXd;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+namespace {
+
+struct Problem {
+  std::vector<float> xy;
+  curvefit::Curve domain;  // basis and x range for polyBasisRow
+  MatrixXd A;
+  VectorXd y;
+};
+
+Problem makeProblem(long n, long order, curvefit::BasisType basis) {
+  Problem p;
+  p.xy.resize(2 * n);
+  unsigned seed = 1;
+  for (long i = 0; i < n; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    double noise = (seed >> 8) * (1.0 / (1 << 24)) - 0.5;
+    p.xy[2 * i] = (float)(10.0 * i);
+    p.xy[2 * i + 1] = (float)(100 * sin(0.01 * i) + noise);
+  }
+  p.domain.basis = basis;
+  p.domain.xMin = 0;
+  p.domain.xMax = 10.0 * (n - 1);
+
+  p.A.resize(n, order);
+  p.y.resize(n);
+  std::vector<double> row(order);
+  for (long i = 0; i < n; i++) {
+    curvefit::polyBasisRow(p.domain, p.xy[2 * i], row.data(), (int)order);
+    for (long j = 0; j < order; j++) p.A(i, j) = row[j];
+    p.y(i) = p.xy[2 * i + 1];
+  }
+  return p;
+}
+
+void BM_Assembly(bench::State &state) {
+  long n = state.range(0), order = state.range(1);
+  Problem p = makeProblem(n, order, curvefit::BASIS_CHEBYSHEV);
+  std::vector<double> row(order);
+  while (state.keepRunning()) {
+    for (long i = 0; i < n; i++) {
+      curvefit::polyBasisRow(p.domain, p.xy[2 * i], row.data(), (int)order);
+      for (long j = 0; j < order; j++) p.A(i, j) = row[j];
+    }
+    bench::doNotOptimize(p.A.data()[0]);
+  }
+  state.setPointsProcessed(n);
+  state.setFlops(3.0 * n * order);
+}
+
+void BM_ColPivHouseholderQr(bench::State &state) {
+  long n = state.range(0), order = state.range(1);
+  Problem p = makeProblem(n, order, curvefit::BASIS_POWER);
+  while (state.keepRunning()) {
+    VectorXd alpha = p.A.colPivHouseholderQr().solve(p.y);
+    bench::doNotOptimize(alpha(0));
+  }
+  state.setPointsProcessed(n);
+  state.setFlops(2.0 * n * order * order - 2.0 / 3 * order * order * order);
+}
+
+void BM_HouseholderQr(bench::State &state) {
+  long n = state.range(0), order = state.range(1);
+  Problem p = makeProblem(n, order, curvefit::BASIS_CHEBYSHEV);
+  while (state.keepRunning()) {
+    VectorXd alpha = p.A.householderQr().solve(p.y);
+    bench::doNotOptimize(alpha(0));
+  }
+  state.setPointsProcessed(n);
+  state.setFlops(2.0 * n * order * order - 2.0 / 3 * order * order * order);
+}
+
+void BM_BdcSvd(bench::State &state) {
+  long n = state.range(0), order = state.range(1);
+  Problem p = makeProblem(n, order, curvefit::BASIS_POWER);
+  while (state.keepRunning()) {
+    VectorXd alpha =
+        p.A.bdcSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(p.y);
+    bench::doNotOptimize(alpha(0));
+  }
+  state.setPointsProcessed(n);
+  // R-SVD with thin U and V
+  state.setFlops(6.0 * n * order * order + 20.0 * order * order * order);
+}
+
+// ridge regression through unscaled normal equations and LDLT; fit() goes
+// through solveLeastSquares(), which scales the columns and tries LLT
+// before falling back to QR or SVD
+void BM_NormalEquationsLdlt(bench::State &state) {
+  long n = state.range(0), order = state.range(1);
+  Problem p = makeProblem(n, order, curvefit::BASIS_POWER);
+  while (state.keepRunning()) {
+    MatrixXd AtA = p.A.transpose() * p.A;
+    AtA.diagonal().array() += 0.1;
+    VectorXd alpha = AtA.ldlt().solve(p.A.transpose() * p.y);
+    bench::doNotOptimize(alpha(0));
+  }
+  state.setPointsProcessed(n);
+  state.setFlops(2.0 * n * order * order + 2.0 * n * order +
+                 1.0 / 3 * order * order * order);
+}
+
+// interpolation modes go through fit(), n points give an n x n system
+void BM_FitGauss(bench::State &state) {
+  long n = state.range(0);
+  if (n > 4000) return state.skip("dense n x n kernel");
+  Problem p = makeProblem(n, 1, curvefit::BASIS_POWER);
+  curvefit::FitParams params;
+  params.type = curvefit::FITTING_TWO;
+  params.sigma = 20;
+  while (state.keepRunning()) {
+    curvefit::Curve curve =
+        curvefit::fit(curvefit::interleavedSpan(p.xy.data(), n), params);
+    bench::doNotOptimize(curve.alpha(0));
+  }
+  state.setPointsProcessed(n);
+  state.setFlops(1.0 / 3 * n * n * n + 4.0 * n * n);
+}
+
+void BM_FitCompactRbf(bench::State &state) {
+  long n = state.range(0);
+  Problem p = makeProblem(n, 1, curvefit::BASIS_POWER);
+  while (state.keepRunning()) {
+    curvefit::Curve curve =
+        curvefit::fitCompactRbf(curvefit::interleavedSpan(p.xy.data(), n), 100);
+    bench::doNotOptimize(curve.alpha(0));
+  }
+  state.setPointsProcessed(n);
+}
+
+// tridiagonal spline interpolation, args {n, mode}: 0 natural cubic,
+// 1 clamped cubic, 2 B-spline
+void BM_FitSpline(bench::State &state) {
+  long n = state.range(0);
+  Problem p = makeProblem(n, 1, curvefit::BASIS_POWER);
+  curvefit::PointSpan points = curvefit::interleavedSpan(p.xy.data(), n);
+  while (state.keepRunning()) {
+    curvefit::Curve curve = state.range(1) == 2
+                                ? curvefit::fitBSpline(points)
+                                : curvefit::fitCubicSpline(points,
+                                                           state.range(1) == 1);
+    bench::doNotOptimize(curve.alpha(0));
+  }
+  state.setPointsProcessed(n);
+}
+
+// least squares through fit() with the AUTO policy, args {n, order, mixed}
+void BM_FitLeastSquares(bench::State &state) {
+  long n = state.range(0), order = state.range(1);
+  Problem p = makeProblem(n, 1, curvefit::BASIS_CHEBYSHEV);
+  curvefit::FitParams params;
+  params.type = curvefit::FITTING_THREE;
+  params.basis = curvefit::BASIS_CHEBYSHEV;
+  params.order = (int)order;
+  params.mixedPrecision = state.range(2) != 0;
+  while (state.keepRunning()) {
+    curvefit::Curve curve =
+        curvefit::fit(curvefit::interleavedSpan(p.xy.data(), n), params);
+    bench::doNotOptimize(curve.alpha(0));
+  }
+  state.setPointsProcessed(n);
+  state.setFlops(1.0 * n * order * order + 2.0 * n * order);
+}
+
+// n samples of a curve with order coefficients, args {n, order, basis}:
+// Horner for POWER, Clenshaw for CHEBYSHEV, one exp per center for GAUSS
+// and the centers within one support radius for WENDLAND
+void BM_Evaluate(bench::State &state) {
+  long n = state.range(0), order = state.range(1);
+  curvefit::BasisType basis = (curvefit::BasisType)state.range(2);
+  bool polynomial = basis == curvefit::BASIS_POWER ||
+                    basis == curvefit::BASIS_CHEBYSHEV;
+  Problem p = makeProblem(n, polynomial ? order : 1, basis);
+  curvefit::Curve curve = p.domain;
+  if (polynomial) {
+    curve.alpha = p.A.householderQr().solve(p.y);
+  } else {
+    // evenly spaced centers, each point sees about four Wendland centers
+    double spacing = (curve.xMax - curve.xMin) / order;
+    for (long j = 0; j < order; j++) {
+      curve.centers.push_back(curve.xMin + (j + 0.5) * spacing);
+    }
+    curve.sigma = 2 * spacing;
+    curve.alpha =
+        VectorXd::Ones(basis == curvefit::BASIS_GAUSS ? order + 1 : order);
+  }
+  std::vector<float> ys(n);
+  while (state.keepRunning()) {
+    curvefit::evaluate(curve, p.xy.data(), 2, ys.data(), 1, n);
+    bench::doNotOptimize(ys[0]);
+  }
+  state.setPointsProcessed(n);
+  // Horner and Clenshaw steps, exp() and the center search are not counted
+  if (basis == curvefit::BASIS_POWER) state.setFlops(2.0 * n * order);
+  if (basis == curvefit::BASIS_CHEBYSHEV) state.setFlops(5.0 * n * order);
+}
+
+}  // namespace
+
+BENCHMARK(BM_Assembly)->ranges({{10, 100000}, {4, 16}});
+BENCHMARK(BM_ColPivHouseholderQr)->ranges({{10, 100000}, {4, 16}});
+BENCHMARK(BM_HouseholderQr)->ranges({{10, 100000}, {4, 16}});
+BENCHMARK(BM_BdcSvd)->ranges({{10, 100000}, {4, 16}});
+BENCHMARK(BM_NormalEquationsLdlt)->ranges({{10, 100000}, {4, 16}});
+BENCHMARK(BM_FitGauss)->ranges({{10, 100000}});
+BENCHMARK(BM_FitCompactRbf)->ranges({{10, 100000}});
+BENCHMARK(BM_FitSpline)
+    ->args({1000, 0})
+    ->args({1000000, 0})
+    ->args({1000000, 1})
+    ->args({1000000, 2});
+BENCHMARK(BM_FitLeastSquares)
+    ->args({10000, 4, 0})
+    ->args({10000, 4, 1})
+    ->args({100000, 16, 0})
+    ->args({100000, 16, 1})
+    ->args({100000, 30, 0})
+    ->args({100000, 30, 1});
+BENCHMARK(BM_Evaluate)
+    ->args({100000, 4, curvefit::BASIS_POWER})
+    ->args({100000, 16, curvefit::BASIS_POWER})
+    ->args({100000, 4, curvefit::BASIS_CHEBYSHEV})
+    ->args({100000, 16, curvefit::BASIS_CHEBYSHEV})
+    ->args({100000, 16, curvefit::BASIS_GAUSS})
+    ->args({100000, 128, curvefit::BASIS_GAUSS})
+    ->args({100000, 16, curvefit::BASIS_WENDLAND})
+    ->args({100000, 1024, curvefit::BASIS_WENDLAND});
@@ -0,0 +1,261 @@
+// curvefit-cli - fit point files without a window
+//
+// Every input file is fitted with the same settings and written next to it
+// (or into --output) as <name>.fit.bin / <name>.fit.csv. Files are handed
+// out to a fixed pool of worker threads, one file per task.
+#include <atomic>
+#include <chrono>
+#include <climits>  // Required for: INT_MAX
+#include <cstdio>
+#include <cstdlib>  // Required for: strtod(), strtol()
+#include <cstring>  // Required for: strcmp(), strrchr()
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>  // Required for: stat()
+
+#include "curve_io.h"
+#include "curvefit.h"
+#include "point_io.h"
+#include "solver.h"
+
+struct Options {
+  curvefit::FitParams params;
+  double step = 5;  // sample spacing of the output, 0 for coefficients only
+  curvefit::ExportFormat format = curvefit::EXPORT_CSV;
+  std::string outputDir;  // empty: next to the input
+  int jobs = 0;           // 0: one per hardware thread
+  bool quiet = false;
+  std::vector<std::string> inputs;
+};
+
+static void printUsage(const char *program) {
+  printf(
+      "Usage: %s [options] <points file>...\n"
+      "\n"
+      "Point files are CSV (.csv, .txt) or packed float32 x/y pairs.\n"
+      "\n"
+      "Options:\n"
+      "  -t, --type ONE..EIGHT              fitting mode (default ONE)\n"
+      "  -b, --basis POWER|CHEBYSHEV|LEGENDRE\n"
+      "                                     basis of ONE/THREE/FOUR\n"
+      "  -n, --order N                      basis functions, THREE/FOUR\n"
+      "  -s, --sigma S                      Gauss sigma, TWO\n"
+      "  -r, --support R                    Wendland radius, FIVE\n"
+      "  -l, --lambda L|auto                ridge lambda or GCV, FOUR\n"
+      "      --solver AUTO|LLT|LDLT|QR|SVD|LU\n"
+      "                                     dense decomposition\n"
+      "      --mixed                        float32 solve refined in double\n"
+      "      --step S                       sample spacing, 0 for none\n"
+      "  -f, --format csv|bin               output format (default csv)\n"
+      "  -o, --output DIR                   output directory\n"
+      "  -j, --jobs N                       worker threads\n"
+      "  -q, --quiet                        only report failures\n",
+      program);
+}
+
+static bool parseNumber(const char *text, double *value) {
+  char *end;
+  *value = strtod(text, &end);
+  return end != text && *end == '\0';
+}
+
+// Whole numbers only, so "-n 2.5" is an error rather than 2
+static bool parseInteger(const char *text, int *value) {
+  char *end;
+  long number = strtol(text, &end, 10);
+  if (end == text || *end != '\0' || number < -INT_MAX || number > INT_MAX) {
+    return false;
+  }
+  *value = (int)number;
+  return true;
+}
+
+// Index of name in names, -1 if absent
+static int findName(const char *name, const char *const *names, int count) {
+  for (int i = 0; i < count; i++) {
+    if (strcmp(name, names[i]) == 0) return i;
+  }
+  return -1;
+}
+
+static bool parseOptions(int argc, char **argv, Options *options) {
+  static const char *const types[] = {"ONE", "TWO",   "THREE", "FOUR",
+                                      "FIVE", "SIX", "SEVEN", "EIGHT"};
+  static const char *const bases[] = {"POWER", "CHEBYSHEV", "LEGENDRE"};
+  static const char *const solvers[] = {"AUTO", "LLT", "LDLT",
+                                        "QR",   "SVD", "LU"};
+  static const curvefit::BasisType basisValues[] = {
+      curvefit::BASIS_POWER, curvefit::BASIS_CHEBYSHEV,
+      curvefit::BASIS_LEGENDRE};
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (arg[0] != '-') {
+      options->inputs.push_back(arg);
+      continue;
+    }
+    if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) return false;
+    if (strcmp(arg, "-q") == 0 || strcmp(arg, "--quiet") == 0) {
+      options->quiet = true;
+      continue;
+    }
+    if (strcmp(arg, "--mixed") == 0) {
+      options->params.mixedPrecision = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      fprintf(stderr, "missing value for %s\n", arg);
+      return false;
+    }
+    const char *value = argv[++i];
+    double number = 0;
+    bool ok = true;
+    if (strcmp(arg, "-t") == 0 || strcmp(arg, "--type") == 0) {
+      int index = findName(value, types, 8);
+      ok = index >= 0;
+      if (ok) options->params.type = (curvefit::FittingType)index;
+    } else if (strcmp(arg, "-b") == 0 || strcmp(arg, "--basis") == 0) {
+      int index = findName(value, bases, 3);
+      ok = index >= 0;
+      if (ok) options->params.basis = basisValues[index];
+    } else if (strcmp(arg, "-n") == 0 || strcmp(arg, "--order") == 0) {
+      ok = parseInteger(value, &options->params.order) &&
+           options->params.order >= 1;
+    } else if (strcmp(arg, "-s") == 0 || strcmp(arg, "--sigma") == 0) {
+      ok = parseNumber(value, &number) && number > 0;
+      options->params.sigma = number;
+    } else if (strcmp(arg, "-r") == 0 || strcmp(arg, "--support") == 0) {
+      ok = parseNumber(value, &number) && number > 0;
+      options->params.support = number;
+    } else if (strcmp(arg, "-l") == 0 || strcmp(arg, "--lambda") == 0) {
+      if (strcmp(value, "auto") == 0) {
+        options->params.autoLambda = true;
+      } else {
+        ok = parseNumber(value, &number) && number >= 0;
+        options->params.lambda = number;
+      }
+    } else if (strcmp(arg, "--solver") == 0) {
+      int index = findName(value, solvers, 6);
+      ok = index >= 0;
+      if (ok) options->params.solver = (curvefit::SolverType)index;
+    } else if (strcmp(arg, "--step") == 0) {
+      ok = parseNumber(value, &number) && number >= 0;
+      options->step = number;
+    } else if (strcmp(arg, "-f") == 0 || strcmp(arg, "--format") == 0) {
+      ok = strcmp(value, "csv") == 0 || strcmp(value, "bin") == 0;
+      options->format = strcmp(value, "bin") == 0 ? curvefit::EXPORT_BINARY
+                                                  : curvefit::EXPORT_CSV;
+    } else if (strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0) {
+      options->outputDir = value;
+    } else if (strcmp(arg, "-j") == 0 || strcmp(arg, "--jobs") == 0) {
+      ok = parseInteger(value, &options->jobs) && options->jobs >= 1;
+    } else {
+      fprintf(stderr, "unknown option %s\n", arg);
+      return false;
+    }
+    if (!ok) {
+      fprintf(stderr, "invalid value '%s' for %s\n", value, arg);
+      return false;
+    }
+  }
+  return !options->inputs.empty();
+}
+
+static bool isDirectory(const std::string &path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 && (st.st_mode & S_IFMT) == S_IFDIR;
+}
+
+static std::string outputPath(const Options &options,
+                              const std::string &input) {
+  std::string path = input;
+  if (!options.outputDir.empty()) {
+    size_t slash = input.find_last_of("/\\");
+    std::string name =
+        slash == std::string::npos ? input : input.substr(slash + 1);
+    path = options.outputDir + "/" + name;
+  }
+  return path + (options.format == curvefit::EXPORT_BINARY ? ".fit.bin"
+                                                           : ".fit.csv");
+}
+
+// Fit and export one file, the report is printed in one piece
+static bool processFile(const Options &options, const std::string &input,
+                        std::mutex *printMutex) {
+  auto start = std::chrono::steady_clock::now();
+  char report[512];
+  bool ok = false;
+
+  curvefit::PointFile points;
+  if (!points.load(input.c_str())) {
+    snprintf(report, sizeof(report), "%s: could not load points",
+             input.c_str());
+  } else {
+    curvefit::Curve curve = curvefit::fit(points.span(), options.params);
+    std::string output = outputPath(options, input);
+    if (curve.empty()) {
+      snprintf(report, sizeof(report), "%s: fitting failed (%zu points)",
+               input.c_str(), points.size());
+    } else if (!curvefit::exportCurve(output.c_str(), options.format, curve,
+                                      options.step)) {
+      snprintf(report, sizeof(report), "%s: could not write %s",
+               input.c_str(), output.c_str());
+    } else {
+      double ms = std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+      snprintf(report, sizeof(report),
+               "%s: %zu points, %d coefficients, %s%s, %.1f ms -> %s",
+               input.c_str(), points.size(), (int)curve.alpha.size(),
+               curvefit::solverName(curve.solver),
+               curve.mixedPrecision ? " f32" : "", ms, output.c_str());
+      ok = true;
+    }
+  }
+
+  if (!ok || !options.quiet) {
+    std::lock_guard<std::mutex> lock(*printMutex);
+    fprintf(ok ? stdout : stderr, "%s\n", report);
+  }
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parseOptions(argc, argv, &options)) {
+    printUsage(argv[0]);
+    return 2;
+  }
+  // checked once here, otherwise every file fails with "could not write"
+  if (!options.outputDir.empty() && !isDirectory(options.outputDir)) {
+    fprintf(stderr, "output directory '%s' does not exist or is not a "
+            "directory\n", options.outputDir.c_str());
+    return 2;
+  }
+
+  int jobs = options.jobs;
+  if (jobs <= 0) jobs = (int)std::thread::hardware_concurrency();
+  if (jobs <= 0) jobs = 1;
+  if (jobs > (int)options.inputs.size()) jobs = (int)options.inputs.size();
+
+  // workers take the next unprocessed file until none are left, so large
+  // and small files balance out across the pool
+  std::atomic<size_t> next(0);
+  std::atomic<int> failures(0);
+  std::mutex printMutex;
+  auto work = [&]() {
+    for (size_t i = next++; i < options.inputs.size(); i = next++) {
+      if (!processFile(options, options.inputs[i], &printMutex)) failures++;
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (int i = 1; i < jobs; i++) pool.emplace_back(work);
+  work();  // the main thread is one of the workers
+  for (std::thread &thread : pool) thread.join();
+
+  return failures == 0 ? 0 : 1;
+}
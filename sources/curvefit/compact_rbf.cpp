@@ -0,0 +1,64 @@
+#include "compact_rbf.h"
+
+#include <Eigen/Sparse>
+#include <algorithm>  // Required for: std::sort()
+#include <numeric>    // Required for: std::iota()
+
+namespace curvefit {
+
+double wendlandBasisFunc(double r) {
+  if (r >= 1) return 0;
+  double s = 1 - r;
+  return s * s * s * s * (4 * r + 1);
+}
+
+Curve fitCompactRbf(PointSpan points, double support) {
+  Curve curve;
+  int n = (int)points.size;
+  if (n < 2 || support <= 0) return curve;
+
+  // spatial index: point order sorted by x, neighbors are a sliding window
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&points](int a, int b) {
+    return points.X(a) < points.X(b);
+  });
+  std::vector<double> xs(n);
+  Eigen::VectorXd Y(n);
+  for (int i = 0; i < n; i++) {
+    xs[i] = points.X(order[i]);
+    Y(i) = points.Y(order[i]);
+  }
+
+  // lower triangle of the symmetric kernel matrix
+  std::vector<Eigen::Triplet<double> > entries;
+  entries.reserve(n * 4);
+  double invSupport = 1.0 / support;
+  int first = 0;
+  for (int i = 0; i < n; i++) {
+    while (xs[i] - xs[first] >= support) first++;
+    for (int j = first; j <= i; j++) {
+      entries.push_back(Eigen::Triplet<double>(
+          i, j, wendlandBasisFunc((xs[i] - xs[j]) * invSupport)));
+    }
+  }
+  Eigen::SparseMatrix<double> K(n, n);
+  K.setFromTriplets(entries.begin(), entries.end());
+
+  // sorted order already gives a banded matrix, no fill-reducing ordering
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower,
+                        Eigen::NaturalOrdering<int> >
+      ldlt(K);
+  if (ldlt.info() != Eigen::Success) return curve;
+
+  curve.basis = BASIS_WENDLAND;
+  curve.solver = SOLVER_LDLT;
+  curve.alpha = ldlt.solve(Y);
+  curve.centers = xs;
+  curve.sigma = support;
+  curve.xMin = xs.front();
+  curve.xMax = xs.back();
+  return curve;
+}
+
+}  // namespace curvefit
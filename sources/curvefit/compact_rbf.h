@@ -0,0 +1,24 @@
+// Compactly supported RBF interpolation (FITTING_FIVE)
+//
+// Wendland's C2 function is zero beyond the support radius, so each row of
+// the kernel matrix only holds the points within one radius. With the points
+// sorted by x those form a contiguous window, the matrix is sparse and
+// banded, and a sparse LDLT solves it in close to O(n log n) for well
+// spaced data.
+#ifndef CURVEFIT_COMPACT_RBF_H
+#define CURVEFIT_COMPACT_RBF_H
+
+#include "curvefit.h"
+
+namespace curvefit {
+
+// Wendland C2 function (1 - r)^4 (4r + 1) for r < 1, 0 otherwise
+double wendlandBasisFunc(double r);
+
+// Interpolate points with Wendland functions of the given support radius
+// centered at every point, empty curve if the system is singular
+Curve fitCompactRbf(PointSpan points, double support);
+
+}  // namespace curvefit
+
+#endif  // CURVEFIT_COMPACT_RBF_H
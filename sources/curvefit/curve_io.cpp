@@ -0,0 +1,140 @@
+#include "curve_io.h"
+
+#include <algorithm>  // Required for: std::min(), std::max()
+
+namespace curvefit {
+
+static const char CURVE_MAGIC[4] = {'C', 'V', 'F', 'T'};
+static const uint32_t CURVE_VERSION = 2;
+
+const char *basisName(BasisType basis) {
+  switch (basis) {
+    case BASIS_POWER: return "POWER";
+    case BASIS_GAUSS: return "GAUSS";
+    case BASIS_NEWTON: return "NEWTON";
+    case BASIS_CHEBYSHEV: return "CHEBYSHEV";
+    case BASIS_LEGENDRE: return "LEGENDRE";
+    case BASIS_WENDLAND: return "WENDLAND";
+    case BASIS_CUBIC_SPLINE: return "CUBIC_SPLINE";
+    case BASIS_BSPLINE: return "BSPLINE";
+  }
+  return "UNKNOWN";
+}
+
+bool CurveWriter::open(const char *path, ExportFormat format) {
+  close();
+  file_ = fopen(path, format == EXPORT_BINARY ? "wb" : "w");
+  format_ = format;
+  failed_ = false;
+  if (!file_) return false;
+  // large buffer, samples arrive in chunks of a few kilobytes
+  setvbuf(file_, nullptr, _IOFBF, 1 << 16);
+  return true;
+}
+
+bool CurveWriter::close() {
+  if (!file_) return !failed_;
+  if (fclose(file_) != 0) failed_ = true;
+  file_ = nullptr;
+  return !failed_;
+}
+
+bool CurveWriter::writeCurve(const Curve &curve) {
+  if (!file_) return false;
+  uint32_t coefficients = (uint32_t)curve.alpha.size();
+  uint32_t centers = (uint32_t)curve.centers.size();
+
+  if (format_ == EXPORT_BINARY) {
+    // the trailing reserved word pads the header so the doubles that follow
+    // start on an 8-byte boundary
+    uint32_t header[5] = {CURVE_VERSION, (uint32_t)curve.basis, coefficients,
+                          centers, 0};
+    double domain[4] = {curve.sigma, curve.lambda, curve.xMin, curve.xMax};
+    if (fwrite(CURVE_MAGIC, 1, 4, file_) != 4 ||
+        fwrite(header, sizeof(header), 1, file_) != 1 ||
+        fwrite(domain, sizeof(domain), 1, file_) != 1 ||
+        fwrite(curve.alpha.data(), sizeof(double), coefficients, file_) !=
+            coefficients ||
+        fwrite(curve.centers.data(), sizeof(double), centers, file_) !=
+            centers) {
+      failed_ = true;
+    }
+    return !failed_;
+  }
+
+  fprintf(file_, "# curvefit %u\n", CURVE_VERSION);
+  fprintf(file_, "# basis,%s\n", basisName(curve.basis));
+  fprintf(file_, "# sigma,%.17g\n", curve.sigma);
+  fprintf(file_, "# lambda,%.17g\n", curve.lambda);
+  fprintf(file_, "# domain,%.17g,%.17g\n", curve.xMin, curve.xMax);
+  fprintf(file_, "# j,alpha,center\n");
+  // Gauss keeps the constant term in alpha(0), its centers start at 1
+  int offset = curve.basis == BASIS_GAUSS ? 1 : 0;
+  // spline knots are not paired with coefficients and may outnumber them
+  uint32_t rows = std::max(coefficients, centers + offset);
+  for (uint32_t j = 0; j < rows; j++) {
+    int c = (int)j - offset;
+    fprintf(file_, "# %u,", j);
+    if (j < coefficients) fprintf(file_, "%.17g", curve.alpha(j));
+    if (c >= 0 && c < (int)centers) {
+      fprintf(file_, ",%.17g\n", curve.centers[c]);
+    } else {
+      fprintf(file_, ",\n");
+    }
+  }
+  if (ferror(file_)) failed_ = true;
+  return !failed_;
+}
+
+bool CurveWriter::beginSamples(uint64_t count) {
+  if (!file_) return false;
+  if (format_ == EXPORT_BINARY) {
+    if (fwrite(&count, sizeof(count), 1, file_) != 1) failed_ = true;
+  } else {
+    fprintf(file_, "x,y\n");
+    if (ferror(file_)) failed_ = true;
+  }
+  return !failed_;
+}
+
+bool CurveWriter::writeSamples(const float *xy, size_t count) {
+  if (!file_) return false;
+  if (format_ == EXPORT_BINARY) {
+    if (fwrite(xy, 2 * sizeof(float), count, file_) != count) failed_ = true;
+    return !failed_;
+  }
+  for (size_t i = 0; i < count; i++) {
+    fprintf(file_, "%.9g,%.9g\n", xy[2 * i], xy[2 * i + 1]);
+  }
+  if (ferror(file_)) failed_ = true;
+  return !failed_;
+}
+
+bool CurveWriter::writeUniformSamples(const Curve &curve, double step) {
+  size_t count = sampleCount(curve, step);
+  if (!beginSamples(count)) return false;
+
+  const size_t CHUNK = 4096;
+  float xy[2 * CHUNK];
+  for (size_t first = 0; first < count; first += CHUNK) {
+    size_t m = std::min(CHUNK, count - first);
+    for (size_t i = 0; i < m; i++) {
+      xy[2 * i] = (float)sampleX(curve, step, first + i);
+    }
+    evaluate(curve, xy, 2, xy + 1, 2, m);
+    if (!writeSamples(xy, m)) return false;
+  }
+  return true;
+}
+
+bool exportCurve(const char *path, ExportFormat format, const Curve &curve,
+                 double step) {
+  CurveWriter writer;
+  if (!writer.open(path, format)) return false;
+  bool ok = writer.writeCurve(curve) &&
+            (step > 0 ? writer.writeUniformSamples(curve, step)
+                      : writer.beginSamples(0));
+  return writer.close() && ok;
+}
+
+}  // namespace curvefit
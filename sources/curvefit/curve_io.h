@@ -0,0 +1,67 @@
+// Curve export
+//
+// A curve is written as its basis metadata and coefficients followed by an
+// optional block of samples. Samples are streamed: uniform samples are
+// evaluated and written a chunk at a time, so exporting millions of them
+// never holds more than one chunk in memory.
+//
+// Binary layout, host byte order (little-endian on every supported target):
+//   char[4] "CVFT", uint32 version, uint32 basis,
+//   uint32 coefficient count, uint32 center count, uint32 reserved (0),
+//   double sigma, lambda, xMin, xMax,
+//   double alpha[coefficient count], double centers[center count],
+//   uint64 sample count, float32 [x, y] * sample count
+// Every double and the sample count start on an 8-byte boundary.
+// CSV layout: the same metadata and coefficients as '#' comment lines, then
+// "x,y" rows, so the file loads back as points through PointFile.
+#ifndef CURVEFIT_CURVE_IO_H
+#define CURVEFIT_CURVE_IO_H
+
+#include <cstdint>
+#include <cstdio>
+
+#include "curvefit.h"
+
+namespace curvefit {
+
+typedef enum {
+  EXPORT_BINARY = 0,  // 紧凑二进制
+  EXPORT_CSV          // 文本
+} ExportFormat;
+
+// Name of the basis as written to CSV, e.g. "CHEBYSHEV"
+const char *basisName(BasisType basis);
+
+class CurveWriter {
+ public:
+  CurveWriter() {}
+  ~CurveWriter() { close(); }
+  CurveWriter(const CurveWriter &) = delete;
+  CurveWriter &operator=(const CurveWriter &) = delete;
+
+  bool open(const char *path, ExportFormat format);
+  // Flush and close, false if any write failed
+  bool close();
+
+  // Metadata and coefficients, written once before the samples
+  bool writeCurve(const Curve &curve);
+  // Start the sample block, exactly count samples must follow
+  bool beginSamples(uint64_t count);
+  // Interleaved [x, y] samples, may be called repeatedly
+  bool writeSamples(const float *xy, size_t count);
+  // Uniform samples xMin + i*step, evaluated chunk by chunk
+  bool writeUniformSamples(const Curve &curve, double step);
+
+ private:
+  FILE *file_ = nullptr;
+  ExportFormat format_ = EXPORT_BINARY;
+  bool failed_ = false;
+};
+
+// Write curve and its uniform samples (none if step <= 0) to path
+bool exportCurve(const char *path, ExportFormat format, const Curve &curve,
+                 double step);
+
+}  // namespace curvefit
+
+#endif  // CURVEFIT_CURVE_IO_H
@@ -0,0 +1,304 @@
+#include "curvefit.h"
+
+#include "compact_rbf.h"
+#include "least_squares.h"
+#include "solver.h"
+#include "spline.h"
+
+#include <algorithm>  // Required for: std::min(), std::max()
+#include <cmath>      // Required for: ceil(), exp(), fabs()
+
+namespace curvefit {
+
+using Eigen::ArrayXd;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+double guassBasisFunc(double x, double x0, double sigma) {
+  double d = x - x0;
+  return exp(-d * d / (2 * sigma * sigma));
+}
+
+static bool isOrthogonal(BasisType basis) {
+  return basis == BASIS_CHEBYSHEV || basis == BASIS_LEGENDRE;
+}
+
+double normalizedX(const Curve &curve, double x) {
+  double halfWidth = 0.5 * (curve.xMax - curve.xMin);
+  if (halfWidth <= 0) halfWidth = 1;
+  return (x - 0.5 * (curve.xMax + curve.xMin)) / halfWidth;
+}
+
+void polyBasisRow(const Curve &curve, double x, double *row, int order) {
+  if (order <= 0) return;
+  double t = isOrthogonal(curve.basis) ? normalizedX(curve, x) : x;
+  row[0] = 1;
+  if (order > 1) row[1] = t;
+  for (int j = 1; j + 1 < order; j++) {
+    if (curve.basis == BASIS_CHEBYSHEV) {
+      row[j + 1] = 2 * t * row[j] - row[j - 1];
+    } else if (curve.basis == BASIS_LEGENDRE) {
+      row[j + 1] = ((2 * j + 1) * t * row[j] - j * row[j - 1]) / (j + 1);
+    } else {
+      row[j + 1] = t * row[j];  // 幂基函数
+    }
+  }
+}
+
+// Clenshaw summation of sum alpha(j) * phi_j(t) for the three-term
+// recurrence phi_j+1 = a_j(t) phi_j + b_j phi_j-1, phi_0 = 1, phi_1 = t
+static double clenshaw(BasisType basis, const VectorXd &alpha, double t) {
+  int n = (int)alpha.size();
+  if (n == 0) return 0;
+  if (n == 1) return alpha(0);
+
+  double b1 = 0, b2 = 0;  // b_k+1, b_k+2
+  for (int k = n - 1; k >= 1; k--) {
+    double a, b;  // a_k(t) and b_k+1
+    if (basis == BASIS_CHEBYSHEV) {
+      a = 2 * t;
+      b = -1;
+    } else {
+      a = (2 * k + 1) * t / (k + 1);
+      b = -(double)(k + 1) / (k + 2);
+    }
+    double bk = alpha(k) + a * b1 + b * b2;
+    b2 = b1;
+    b1 = bk;
+  }
+  // phi_1 = t, b_1 = -1 for Chebyshev and -1/2 for Legendre
+  return alpha(0) + t * b1 + (basis == BASIS_CHEBYSHEV ? -1.0 : -0.5) * b2;
+}
+
+// Gauss interpolation with every point as a center plus a constant term
+//   [K 1; 1^T 0] [w; c] = [y; 0]
+// K is symmetric positive definite, so it is factorized once (LLT unless
+// overridden) and the constant comes from the Schur complement:
+//   c = 1^T K^-1 y / 1^T K^-1 1,  w = K^-1 y - c K^-1 1
+static Curve fitGauss(PointSpan points, const FitParams &params) {
+  Curve curve;
+  double sigma = params.sigma;
+  int n = (int)points.size;
+
+  VectorXd xs(n);
+  MatrixXd rhs(n, 2);  // [y, 1]
+  for (int i = 0; i < n; i++) {
+    xs(i) = points.X(i);
+    rhs(i, 0) = points.Y(i);
+  }
+  rhs.col(1).setOnes();
+
+  // lower triangle only, one vectorized exp per column
+  double scale = -1.0 / (2 * sigma * sigma);
+  MatrixXd K(n, n);
+  for (int j = 0; j < n; j++) {
+    K.col(j).tail(n - j) =
+        ((xs.tail(n - j).array() - xs(j)).square() * scale).exp().matrix();
+  }
+
+  MatrixXd ab;  // [K^-1 y, K^-1 1]
+  if (params.mixedPrecision &&
+      solveSymmetricMixed(K, rhs, params.solver, &ab, &curve.solver)) {
+    curve.mixedPrecision = true;
+  } else {
+    curve.solver = solveSymmetric(K, rhs, params.solver, &ab);
+  }
+  double c = ab.col(0).sum() / ab.col(1).sum();
+
+  curve.basis = BASIS_GAUSS;
+  curve.alpha.resize(n + 1);
+  curve.alpha(0) = c;
+  curve.alpha.tail(n) = ab.col(0) - c * ab.col(1);
+  curve.centers.assign(xs.data(), xs.data() + n);
+  curve.sigma = sigma;
+  curve.xMin = xs.minCoeff();
+  curve.xMax = xs.maxCoeff();
+  return curve;
+}
+
+Curve fit(PointSpan points, const FitParams &params) {
+  Curve curve;
+  if (points.size < 2) return curve;
+
+  if (params.type == FITTING_TWO) return fitGauss(points, params);
+  if (params.type == FITTING_FIVE) {
+    return fitCompactRbf(points, params.support);
+  }
+  if (params.type == FITTING_SIX || params.type == FITTING_SEVEN) {
+    return fitCubicSpline(points, params.type == FITTING_SEVEN);
+  }
+  if (params.type == FITTING_EIGHT) return fitBSpline(points);
+
+  if (params.type == FITTING_FOUR && params.autoLambda) {
+    LeastSquaresCache cache;
+    cache.build(points, params.basis, params.order);
+    RidgeSweep ridge(cache, params.order);
+    return ridge.solve(ridge.bestLambda());
+  }
+
+  // A * alpha = B
+  int n = (int)points.size;
+  int order = params.type == FITTING_THREE || params.type == FITTING_FOUR
+                  ? std::max(params.order, 1)
+                  : n;
+  VectorXd Y(n);
+  for (int i = 0; i < n; i++) Y(i) = points.Y(i);
+
+  // cal sample range, also the domain of the orthogonal bases
+  curve.xMin = curve.xMax = points.X(0);
+  for (int i = 1; i < n; i++) {
+    if (points.X(i) > curve.xMax) curve.xMax = points.X(i);
+    if (points.X(i) < curve.xMin) curve.xMin = points.X(i);
+  }
+  curve.basis = params.basis;
+  if (params.type == FITTING_FOUR) curve.lambda = params.lambda;
+
+  if (params.mixedPrecision) {
+    // rows are generated in double on demand, A itself is only kept in float
+    auto basisRows = [&](Eigen::Index first, Eigen::Index count,
+                         double *rows) {
+      for (Eigen::Index i = 0; i < count; i++) {
+        polyBasisRow(curve, points.X(first + i), rows + i * order, order);
+      }
+    };
+    if (solveLeastSquaresMixed(n, order, basisRows, Y, curve.lambda,
+                               params.solver, &curve.alpha, &curve.solver)) {
+      curve.mixedPrecision = true;
+      return curve;
+    }
+  }
+
+  // initialize
+  MatrixXd A(n, order);
+  std::vector<double> row(order);
+  for (int i = 0; i < n; i++) {
+    polyBasisRow(curve, points.X(i), row.data(), order);  // 幂基函数的线性组合
+    for (int j = 0; j < order; j++) A(i, j) = row[j];
+  }
+
+  // interpolation (n x n), regression and ridge regression are all least
+  // squares problems, the solver policy picks the decomposition
+  curve.solver =
+      solveLeastSquares(A, Y, curve.lambda, params.solver, &curve.alpha);
+
+  return curve;
+}
+
+// Only the sorted centers within one support radius of x contribute
+static double evaluateCompact(const Curve &curve, double x) {
+  const std::vector<double> &c = curve.centers;
+  double y = 0;
+  for (size_t j = std::lower_bound(c.begin(), c.end(), x - curve.sigma) -
+                  c.begin();
+       j < c.size() && c[j] < x + curve.sigma; j++) {
+    y += curve.alpha(j) * wendlandBasisFunc(fabs(x - c[j]) / curve.sigma);
+  }
+  return y;
+}
+
+double evaluate(const Curve &curve, double x) {
+  double y = 0;
+  if (curve.basis == BASIS_POWER) {
+    // Horner's scheme
+    for (int j = (int)curve.alpha.size() - 1; j >= 0; j--) {
+      y = y * x + curve.alpha(j);
+    }
+  } else if (curve.basis == BASIS_GAUSS) {
+    y = curve.alpha(0);
+    for (size_t j = 0; j < curve.centers.size(); j++) {
+      y += curve.alpha(j + 1) * guassBasisFunc(x, curve.centers[j], curve.sigma);
+    }
+  } else if (isOrthogonal(curve.basis)) {
+    y = clenshaw(curve.basis, curve.alpha, normalizedX(curve, x));
+  } else if (curve.basis == BASIS_NEWTON) {
+    // nested multiplication
+    for (int j = (int)curve.alpha.size() - 1; j >= 0; j--) {
+      y = y * (x - curve.centers[j]) + curve.alpha(j);
+    }
+  } else if (curve.basis == BASIS_WENDLAND) {
+    y = evaluateCompact(curve, x);
+  } else if (curve.basis == BASIS_CUBIC_SPLINE) {
+    y = evaluateCubicSpline(curve, x);
+  } else if (curve.basis == BASIS_BSPLINE) {
+    y = evaluateBSpline(curve, x);
+  }
+  return y;
+}
+
+void evaluate(const Curve &curve, const ArrayXd &x, ArrayXd *y) {
+  int n = (int)curve.alpha.size();
+  y->setZero(x.size());
+  if (n == 0) return;
+
+  // every basis is a loop over coefficients with whole-array (SIMD) updates
+  if (curve.basis == BASIS_POWER) {
+    for (int j = n - 1; j >= 0; j--) *y = *y * x + curve.alpha(j);
+  } else if (curve.basis == BASIS_GAUSS) {
+    double scale = -1.0 / (2 * curve.sigma * curve.sigma);
+    y->setConstant(curve.alpha(0));
+    for (size_t j = 0; j < curve.centers.size(); j++) {
+      *y += curve.alpha(j + 1) * ((x - curve.centers[j]).square() * scale).exp();
+    }
+  } else if (isOrthogonal(curve.basis)) {
+    double halfWidth = 0.5 * (curve.xMax - curve.xMin);
+    if (halfWidth <= 0) halfWidth = 1;
+    ArrayXd t = (x - 0.5 * (curve.xMax + curve.xMin)) / halfWidth;
+    ArrayXd b1 = ArrayXd::Zero(x.size()), b2 = ArrayXd::Zero(x.size());
+    bool chebyshev = curve.basis == BASIS_CHEBYSHEV;
+    for (int k = n - 1; k >= 1; k--) {
+      double a = chebyshev ? 2.0 : (2.0 * k + 1) / (k + 1);
+      double b = chebyshev ? -1.0 : -(double)(k + 1) / (k + 2);
+      b2 = curve.alpha(k) + a * t * b1 + b * b2;  // b_k into b_k+2
+      b1.swap(b2);
+    }
+    *y = curve.alpha(0) + t * b1 + (chebyshev ? -1.0 : -0.5) * b2;
+  } else if (curve.basis == BASIS_NEWTON) {
+    for (int j = n - 1; j >= 0; j--) {
+      *y = *y * (x - curve.centers[j]) + curve.alpha(j);
+    }
+  } else if (curve.basis == BASIS_WENDLAND) {
+    for (Eigen::Index i = 0; i < x.size(); i++) {
+      (*y)(i) = evaluateCompact(curve, x(i));
+    }
+  } else if (curve.basis == BASIS_CUBIC_SPLINE) {
+    for (Eigen::Index i = 0; i < x.size(); i++) {
+      (*y)(i) = evaluateCubicSpline(curve, x(i));
+    }
+  } else if (curve.basis == BASIS_BSPLINE) {
+    for (Eigen::Index i = 0; i < x.size(); i++) {
+      (*y)(i) = evaluateBSpline(curve, x(i));
+    }
+  }
+}
+
+void evaluate(const Curve &curve, const float *xs, size_t xStride, float *ys,
+              size_t yStride, size_t count) {
+  typedef Eigen::Map<const Eigen::ArrayXf, 0, Eigen::InnerStride<> > InMap;
+  typedef Eigen::Map<Eigen::ArrayXf, 0, Eigen::InnerStride<> > OutMap;
+
+  // chunks stay in L1 cache between the passes over the coefficients
+  const size_t CHUNK = 256;
+  ArrayXd x, y;
+  for (size_t i = 0; i < count; i += CHUNK) {
+    Eigen::Index m = (Eigen::Index)std::min(CHUNK, count - i);
+    x = InMap(xs + i * xStride, m, Eigen::InnerStride<>(xStride))
+            .cast<double>();
+    evaluate(curve, x, &y);
+    OutMap(ys + i * yStride, m, Eigen::InnerStride<>(yStride)) =
+        y.cast<float>();
+  }
+}
+
+size_t sampleCount(const Curve &curve, double step) {
+  if (curve.empty() || step <= 0) return 0;
+  return (size_t)ceil((curve.xMax - curve.xMin) / step) + 1;
+}
+
+void sampleUniform(const Curve &curve, double step, float *xy, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    xy[2 * i] = (float)sampleX(curve, step, i);
+  }
+  evaluate(curve, xy, 2, xy + 1, 2, count);
+}
+
+}  // namespace curvefit
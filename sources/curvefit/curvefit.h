@@ -0,0 +1,149 @@
+// curvefit - headless curve fitting used by games102-hw1
+//
+// No raylib dependency: points are passed as strided float views so a
+// std::vector<Vector2> (or any interleaved x/y buffer) can be used directly.
+#ifndef CURVEFIT_H
+#define CURVEFIT_H
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+
+namespace curvefit {
+
+typedef enum {
+  FITTING_ONE = 0,  // 插值 幂基函数线性组合
+  FITTING_TWO,      // 插值 Gauss基函数线性组合
+  FITTING_THREE,    // 逼近 固定幂基函数，最小二乘
+  FITTING_FOUR,     // 逼近 岭回归
+  FITTING_FIVE,     // 插值 紧支撑径向基函数 (Wendland)，稀疏求解
+  FITTING_SIX,      // 插值 自然三次样条，三对角求解
+  FITTING_SEVEN,    // 插值 固定端点三次样条，三对角求解
+  FITTING_EIGHT     // 插值 三次B样条，节点取数据点
+} FittingType;
+
+typedef enum {
+  BASIS_POWER = 0,     // y = sum alpha(j) * x^j
+  BASIS_GAUSS,         // y = alpha(0) + sum alpha(j + 1) * g(x, centers[j])
+  BASIS_NEWTON,        // y = sum alpha(j) * (x - centers[0]) ... (x - centers[j-1])
+  BASIS_CHEBYSHEV,     // y = sum alpha(j) * T_j(t), t = x mapped to [-1, 1]
+  BASIS_LEGENDRE,      // y = sum alpha(j) * P_j(t), t = x mapped to [-1, 1]
+  BASIS_WENDLAND,      // y = sum alpha(j) * w(|x - centers[j]| / sigma)
+  BASIS_CUBIC_SPLINE,  // piecewise cubic, see spline.h
+  BASIS_BSPLINE        // y = sum alpha(j) * N_j-3(x), knots in centers
+} BasisType;
+
+typedef enum {
+  SOLVER_AUTO = 0,  // 按规模和条件数自动选择
+  SOLVER_LLT,       // normal equations, Cholesky
+  SOLVER_LDLT,      // normal equations, pivoting LDL^T
+  SOLVER_QR,        // column pivoting Householder QR
+  SOLVER_SVD,       // bidiagonal divide and conquer SVD
+  SOLVER_LU         // partial pivoting LU, square systems
+} SolverType;
+
+// Read-only view over 2D points, stride is the distance between two
+// consecutive points counted in floats
+struct PointSpan {
+  const float *x;
+  const float *y;
+  size_t size;
+  size_t stride;
+
+  PointSpan() : x(nullptr), y(nullptr), size(0), stride(1) {}
+  PointSpan(const float *x, const float *y, size_t size, size_t stride = 1)
+      : x(x), y(y), size(size), stride(stride) {}
+
+  float X(size_t i) const { return x[i * stride]; }
+  float Y(size_t i) const { return y[i * stride]; }
+};
+
+// View over interleaved [x0, y0, x1, y1, ...] data, e.g. &points[0].x
+inline PointSpan interleavedSpan(const float *xy, size_t count) {
+  return PointSpan(xy, xy + 1, count, 2);
+}
+
+struct FitParams {
+  FittingType type;
+  BasisType basis;  // polynomial basis for FITTING_ONE/THREE/FOUR
+  int order;        // number of basis functions for FITTING_THREE/FOUR
+  double sigma;     // * for guass basis
+  double support;   // * for compact support basis, radius
+  double lambda;    // * for ridge regression
+  bool autoLambda;  // pick lambda by generalized cross-validation instead
+  SolverType solver;  // dense decomposition, see solver.h
+  bool mixedPrecision;  // float32 factorization refined in double
+
+  FitParams()
+      : type(FITTING_ONE), basis(BASIS_POWER), order(2), sigma(20),
+        support(100), lambda(0.1), autoLambda(false), solver(SOLVER_AUTO),
+        mixedPrecision(false) {}
+};
+
+inline bool operator==(const FitParams &a, const FitParams &b) {
+  return a.type == b.type && a.basis == b.basis && a.order == b.order &&
+         a.sigma == b.sigma && a.support == b.support &&
+         a.lambda == b.lambda &&
+         a.autoLambda == b.autoLambda && a.solver == b.solver &&
+         a.mixedPrecision == b.mixedPrecision;
+}
+inline bool operator!=(const FitParams &a, const FitParams &b) {
+  return !(a == b);
+}
+
+// Fitted function y = f(x) over the x range of the input points, which is
+// also the [-1, 1] domain of the orthogonal bases
+struct Curve {
+  BasisType basis;
+  Eigen::VectorXd alpha;        // basis coefficients
+  std::vector<double> centers;  // Gauss/Wendland centers, nodes or knots
+  double sigma;                 // Gauss sigma or Wendland support radius
+  double lambda;  // ridge regularization used, 0 for the other modes
+  double xMin, xMax;
+  SolverType solver;  // decomposition that produced alpha, AUTO if none
+  bool mixedPrecision;  // solver ran in float32 with refinement
+
+  Curve()
+      : basis(BASIS_POWER), sigma(0), lambda(0), xMin(0), xMax(0),
+        solver(SOLVER_AUTO), mixedPrecision(false) {}
+
+  bool empty() const { return alpha.size() == 0; }
+};
+
+// Gauss basis function centered at x0
+double guassBasisFunc(double x, double x0, double sigma);
+
+// Map x from [curve.xMin, curve.xMax] to [-1, 1]
+double normalizedX(const Curve &curve, double x);
+
+// Fill row[0..order) with the polynomial basis functions at x
+void polyBasisRow(const Curve &curve, double x, double *row, int order);
+
+// Fit points using params.type, returns an empty curve for less than 2 points
+Curve fit(PointSpan points, const FitParams &params);
+
+// Evaluate curve at x
+double evaluate(const Curve &curve, double x);
+
+// Evaluate all x at once, y = f(x)
+void evaluate(const Curve &curve, const Eigen::ArrayXd &x, Eigen::ArrayXd *y);
+
+// Evaluate count samples: ys[i*yStride] = f(xs[i*xStride])
+void evaluate(const Curve &curve, const float *xs, size_t xStride, float *ys,
+              size_t yStride, size_t count);
+
+// Number of samples xMin + i*step in [xMin, xMax], plus xMax itself
+size_t sampleCount(const Curve &curve, double step);
+
+// x of uniform sample i, the last one is clamped to xMax
+inline double sampleX(const Curve &curve, double step, size_t i) {
+  double x = curve.xMin + i * step;
+  return x < curve.xMax ? x : curve.xMax;
+}
+
+// Write count samples as interleaved [x, y] pairs into xy
+void sampleUniform(const Curve &curve, double step, float *xy, size_t count);
+
+}  // namespace curvefit
+
+#endif  // CURVEFIT_H
@@ -0,0 +1,136 @@
+#include "incremental.h"
+
+#include <algorithm>  // Required for: std::min(), std::max()
+#include <cmath>      // Required for: sqrt()
+
+namespace curvefit {
+
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+// Capacity of the growing buffers, doubled when exceeded
+static Eigen::Index grownCapacity(Eigen::Index current, Eigen::Index needed) {
+  Eigen::Index capacity = std::max<Eigen::Index>(current, 16);
+  while (capacity < needed) capacity *= 2;
+  return capacity;
+}
+
+void NewtonInterpolator::clear() {
+  nodes_.clear();
+  coeffs_.clear();
+  diag_.clear();
+}
+
+bool NewtonInterpolator::append(double x, double y) {
+  for (size_t i = 0; i < nodes_.size(); i++) {
+    if (nodes_[i] == x) return false;
+  }
+
+  // new diagonal: f[xn], f[xn-1,xn], ..., f[x0..xn]
+  size_t n = nodes_.size();
+  double prev = y;
+  for (size_t k = 0; k < n; k++) {
+    double next = (prev - diag_[k]) / (x - nodes_[n - 1 - k]);
+    diag_[k] = prev;
+    prev = next;
+  }
+  diag_.push_back(prev);
+  coeffs_.push_back(prev);
+  nodes_.push_back(x);
+
+  xMin_ = n == 0 ? x : std::min(xMin_, x);
+  xMax_ = n == 0 ? x : std::max(xMax_, x);
+  return true;
+}
+
+bool NewtonInterpolator::update(PointSpan points) {
+  if (points.size < size()) clear();
+  for (size_t i = size(); i < points.size; i++) {
+    if (!append(points.X(i), points.Y(i))) return false;
+  }
+  return true;
+}
+
+Curve NewtonInterpolator::curve() const {
+  Curve curve;
+  if (nodes_.size() < 2) return curve;
+
+  curve.basis = BASIS_NEWTON;
+  curve.alpha = Eigen::Map<const VectorXd>(coeffs_.data(), coeffs_.size());
+  curve.centers = nodes_;
+  curve.xMin = xMin_;
+  curve.xMax = xMax_;
+  return curve;
+}
+
+void GaussInterpolator::clear() { nodes_.clear(); }
+
+void GaussInterpolator::setSigma(double sigma) {
+  if (sigma != sigma_) clear();
+  sigma_ = sigma;
+}
+
+bool GaussInterpolator::append(double x, double y) {
+  Eigen::Index n = (Eigen::Index)nodes_.size();
+  if (L_.rows() < n + 1) {
+    Eigen::Index capacity = grownCapacity(L_.rows(), n + 1);
+    MatrixXd L(capacity, capacity);
+    L.topLeftCorner(n, n) = L_.topLeftCorner(n, n);
+    L_.swap(L);
+    z_.conservativeResize(capacity);
+    u_.conservativeResize(capacity);
+  }
+
+  // new row l of L solves L l = k, k(j) = g(x, x_j)
+  VectorXd k(n);
+  for (Eigen::Index j = 0; j < n; j++) {
+    k(j) = guassBasisFunc(x, nodes_[j], sigma_);
+  }
+  VectorXd l = L_.topLeftCorner(n, n).triangularView<Eigen::Lower>().solve(k);
+  double d = 1.0 - l.squaredNorm();
+  if (d <= 1e-12) return false;
+  double lnn = sqrt(d);
+
+  L_.row(n).head(n) = l.transpose();
+  L_(n, n) = lnn;
+  z_(n) = (y - l.dot(z_.head(n))) / lnn;
+  u_(n) = (1.0 - l.dot(u_.head(n))) / lnn;
+  nodes_.push_back(x);
+
+  xMin_ = n == 0 ? x : std::min(xMin_, x);
+  xMax_ = n == 0 ? x : std::max(xMax_, x);
+  return true;
+}
+
+bool GaussInterpolator::update(PointSpan points) {
+  if (points.size < size()) clear();
+  for (size_t i = size(); i < points.size; i++) {
+    if (!append(points.X(i), points.Y(i))) return false;
+  }
+  return true;
+}
+
+Curve GaussInterpolator::curve() const {
+  Curve curve;
+  Eigen::Index n = (Eigen::Index)nodes_.size();
+  if (n < 2) return curve;
+
+  // K^-1 y = L^-T z, K^-1 1 = L^-T u
+  // constraint 1^T w = 0 gives c = (u . z) / (u . u), then w = L^-T (z - c u)
+  double c = u_.head(n).dot(z_.head(n)) / u_.head(n).squaredNorm();
+  VectorXd w = L_.topLeftCorner(n, n).transpose().triangularView<Eigen::Upper>()
+                   .solve(z_.head(n) - c * u_.head(n));
+
+  curve.basis = BASIS_GAUSS;
+  curve.solver = SOLVER_LLT;  // incremental Cholesky
+  curve.alpha.resize(n + 1);
+  curve.alpha(0) = c;
+  curve.alpha.tail(n) = w;
+  curve.centers = nodes_;
+  curve.sigma = sigma_;
+  curve.xMin = xMin_;
+  curve.xMax = xMax_;
+  return curve;
+}
+
+}  // namespace curvefit
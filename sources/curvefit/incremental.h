@@ -0,0 +1,65 @@
+// Incremental interpolation: appending one point reuses the previous state
+// instead of rebuilding and refactorizing the n x n system
+#ifndef CURVEFIT_INCREMENTAL_H
+#define CURVEFIT_INCREMENTAL_H
+
+#include <vector>
+
+#include "curvefit.h"
+
+namespace curvefit {
+
+// Power basis interpolation in Newton form (FITTING_ONE), divided differences
+// are extended in O(n) per appended point
+class NewtonInterpolator {
+ public:
+  void clear();
+  size_t size() const { return nodes_.size(); }
+
+  // Append a point, false if x duplicates an existing node
+  bool append(double x, double y);
+  // Append points[size()..points.size), restart if points shrank
+  bool update(PointSpan points);
+
+  Curve curve() const;
+
+ private:
+  std::vector<double> nodes_;
+  std::vector<double> coeffs_;  // f[x0], f[x0,x1], ..., f[x0..xn-1]
+  std::vector<double> diag_;    // f[xn-1], f[xn-2,xn-1], ..., f[x0..xn-1]
+  double xMin_ = 0, xMax_ = 0;
+};
+
+// Gauss basis interpolation with a constant term (FITTING_TWO):
+//   [K 1; 1^T 0] [w; c] = [y; 0],  K(i, j) = g(x_i, x_j)
+// The Cholesky factor K = L L^T grows by one row per point, O(n^2) per
+// appended point, and solving reuses L in O(n^2)
+class GaussInterpolator {
+ public:
+  explicit GaussInterpolator(double sigma = 20) : sigma_(sigma) {}
+
+  void clear();
+  size_t size() const { return nodes_.size(); }
+  double sigma() const { return sigma_; }
+  // Changing sigma invalidates the factorization
+  void setSigma(double sigma);
+
+  // Append a point, false if K stops being numerically positive definite
+  bool append(double x, double y);
+  // Append points[size()..points.size), restart if points shrank
+  bool update(PointSpan points);
+
+  Curve curve() const;
+
+ private:
+  double sigma_;
+  std::vector<double> nodes_;
+  Eigen::MatrixXd L_;  // capacity grows geometrically, valid block is n x n
+  Eigen::VectorXd z_;  // L^-1 y
+  Eigen::VectorXd u_;  // L^-1 1
+  double xMin_ = 0, xMax_ = 0;
+};
+
+}  // namespace curvefit
+
+#endif  // CURVEFIT_INCREMENTAL_H
@@ -0,0 +1,163 @@
+#include "least_squares.h"
+
+#include <algorithm>  // Required for: std::min(), std::max()
+#include <cmath>      // Required for: fabs(), pow(), INFINITY
+
+namespace curvefit {
+
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+// Columns closer than this, relative to their norm, to the span of the
+// columns before them are treated as dependent
+static const double RANK_TOLERANCE = 1e-10;
+
+void LeastSquaresCache::clear() {
+  R_.resize(0, 0);
+  qty_.resize(0);
+  n_ = 0;
+}
+
+void LeastSquaresCache::build(PointSpan points, BasisType basis,
+                              int maxOrder) {
+  clear();
+  if (points.size < 1 || maxOrder < 1) return;
+
+  int n = (int)points.size;
+  int m = std::min(maxOrder, n);
+  domain_ = Curve();
+  domain_.basis = basis;
+  domain_.xMin = domain_.xMax = points.X(0);
+  for (int i = 1; i < n; i++) {
+    domain_.xMin = std::min<double>(domain_.xMin, points.X(i));
+    domain_.xMax = std::max<double>(domain_.xMax, points.X(i));
+  }
+
+  MatrixXd A(n, m);
+  VectorXd Y(n);
+  std::vector<double> row(m);
+  for (int i = 0; i < n; i++) {
+    polyBasisRow(domain_, points.X(i), row.data(), m);
+    for (int j = 0; j < m; j++) A(i, j) = row[j];
+    Y(i) = points.Y(i);
+  }
+
+  // Householder QR without pivoting keeps the column order, so leading
+  // blocks of R belong to lower orders
+  Eigen::HouseholderQR<MatrixXd> qr(A);
+  R_ = qr.matrixQR().topRows(m).triangularView<Eigen::Upper>();
+  yNorm2_ = Y.squaredNorm();
+  Y.applyOnTheLeft(qr.householderQ().adjoint());
+  qty_ = Y.head(m);
+  n_ = points.size;
+}
+
+Curve LeastSquaresCache::solve(int order) const {
+  Curve curve;
+  int k = std::min(order, maxOrder());
+  if (k < 1) return curve;
+
+  // R(i, i) is the part of column i outside the span of the columns before
+  // it, |column i| = |R(0..i, i)|. Repeated x values make it vanish, and the
+  // unpivoted back-substitution would divide by (almost) zero
+  for (int i = 0; i < k; i++) {
+    double column = R_.col(i).head(i + 1).norm();
+    if (!(fabs(R_(i, i)) > RANK_TOLERANCE * column)) return curve;
+  }
+
+  curve = domain_;
+  curve.alpha = R_.topLeftCorner(k, k).triangularView<Eigen::Upper>().solve(
+      qty_.head(k));
+  curve.solver = SOLVER_QR;
+  return curve;
+}
+
+Curve LeastSquaresCache::solveRidge(int order, double lambda) const {
+  Curve curve;
+  int k = std::min(order, maxOrder());
+  if (k < 1) return curve;
+
+  // A^T A = R^T R and A^T y = R^T Q^T y for the first k columns
+  MatrixXd Rk = R_.topLeftCorner(k, k);
+  MatrixXd A1 = Rk.transpose() * Rk;
+  A1.diagonal().array() += lambda;
+  curve = domain_;
+  curve.alpha = A1.ldlt().solve(Rk.transpose() * qty_.head(k));
+  curve.lambda = lambda;
+  curve.solver = SOLVER_LDLT;
+  return curve;
+}
+
+RidgeSweep::RidgeSweep(const LeastSquaresCache &cache, int order)
+    : order_(0), outside2_(0), n_(0) {
+  int k = std::min(order, cache.maxOrder());
+  if (k < 1) return;
+
+  // R_k is only k x k, its SVD is cheap compared to the SVD of A_k
+  Eigen::JacobiSVD<MatrixXd> svd(cache.R_.topLeftCorner(k, k),
+                                 Eigen::ComputeFullU | Eigen::ComputeFullV);
+  domain_ = cache.domain_;
+  V_ = svd.matrixV();
+  s_ = svd.singularValues();
+  beta_ = svd.matrixU().transpose() * cache.qty_.head(k);
+  outside2_ = std::max(0.0, cache.yNorm2_ - beta_.squaredNorm());
+  n_ = cache.n_;
+  order_ = k;
+}
+
+Curve RidgeSweep::solve(double lambda) const {
+  Curve curve;
+  if (empty()) return curve;
+
+  VectorXd s2 = s_.array().square();
+  curve = domain_;
+  curve.alpha = V_ * (s_.array() / (s2.array() + lambda) * beta_.array())
+                         .matrix();
+  curve.lambda = lambda;
+  curve.solver = SOLVER_SVD;
+  return curve;
+}
+
+double RidgeSweep::gcv(double lambda) const {
+  double residual2 = outside2_;
+  double traceH = 0;
+  for (int i = 0; i < order_; i++) {
+    double f = s_(i) * s_(i) / (s_(i) * s_(i) + lambda);
+    residual2 += (1 - f) * (1 - f) * beta_(i) * beta_(i);
+    traceH += f;
+  }
+  double dof = (double)n_ - traceH;
+  return dof > 0 ? n_ * residual2 / (dof * dof) : INFINITY;
+}
+
+std::vector<double> RidgeSweep::lambdaGrid(int count) const {
+  std::vector<double> lambdas;
+  if (empty() || count < 1) return lambdas;
+
+  double top = std::max(s_(0) * s_(0), 1e-300);
+  for (int i = 0; i < count; i++) {
+    double t = count > 1 ? (double)i / (count - 1) : 1;
+    lambdas.push_back(top * pow(10.0, -12 * (1 - t)));
+  }
+  return lambdas;
+}
+
+int RidgeSweep::gcvCurve(const std::vector<double> &lambdas,
+                         std::vector<double> *scores) const {
+  scores->resize(lambdas.size());
+  int best = -1;
+  for (size_t i = 0; i < lambdas.size(); i++) {
+    (*scores)[i] = gcv(lambdas[i]);
+    if (best < 0 || (*scores)[i] < (*scores)[best]) best = (int)i;
+  }
+  return best;
+}
+
+double RidgeSweep::bestLambda(int count) const {
+  std::vector<double> lambdas = lambdaGrid(count);
+  std::vector<double> scores;
+  int best = gcvCurve(lambdas, &scores);
+  return best < 0 ? 0 : lambdas[best];
+}
+
+}  // namespace curvefit
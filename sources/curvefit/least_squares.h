@@ -0,0 +1,84 @@
+// Cached least squares factorization for FITTING_THREE/FOUR
+//
+// The basis matrix A = [phi_0(x) .. phi_m-1(x)] is factorized once as A = QR
+// for the largest order m. The first k columns of A factor as the leading
+// k x k block of R, so any order k <= m costs one back-substitution, and
+// ridge solves only touch the small R instead of the n x k matrix A.
+#ifndef CURVEFIT_LEAST_SQUARES_H
+#define CURVEFIT_LEAST_SQUARES_H
+
+#include "curvefit.h"
+
+namespace curvefit {
+
+class RidgeSweep;
+
+class LeastSquaresCache {
+ public:
+  LeastSquaresCache() : n_(0) {}
+
+  // Factorize the basis matrix of points for orders up to maxOrder
+  void build(PointSpan points, BasisType basis, int maxOrder);
+  void clear();
+
+  bool empty() const { return R_.size() == 0; }
+  BasisType basis() const { return domain_.basis; }
+  int maxOrder() const { return (int)R_.cols(); }
+  size_t size() const { return n_; }
+
+  // Least squares fit with order basis functions, order <= maxOrder().
+  // Empty when those columns are numerically dependent (fewer distinct x
+  // than order), fit() handles that case
+  Curve solve(int order) const;
+  // Ridge regression (A^T A + lambda I) alpha = A^T y, order <= maxOrder()
+  Curve solveRidge(int order, double lambda) const;
+
+ private:
+  friend class RidgeSweep;
+
+  Curve domain_;            // basis and x range, no coefficients
+  Eigen::MatrixXd R_;       // m x m upper triangular
+  Eigen::VectorXd qty_;     // first m entries of Q^T y
+  double yNorm2_;           // |y|^2, for residuals
+  size_t n_;
+};
+
+// Ridge regression of one order for many lambdas
+//
+// With the SVD A_k = U S V^T (taken from the small R_k = U_r S V^T) the ridge
+// solution is alpha = V diag(s / (s^2 + lambda)) U^T y, so a new lambda costs
+// O(order^2) and its generalized cross-validation score
+//   GCV(lambda) = n |y - A alpha|^2 / (n - tr H)^2,  tr H = sum s^2/(s^2+lambda)
+// costs O(order)
+class RidgeSweep {
+ public:
+  RidgeSweep() : order_(0), outside2_(0), n_(0) {}
+  RidgeSweep(const LeastSquaresCache &cache, int order);
+
+  bool empty() const { return order_ == 0; }
+  int order() const { return order_; }
+
+  Curve solve(double lambda) const;
+  double gcv(double lambda) const;
+
+  // count lambdas log-spaced over [s_max^2 * 1e-12, s_max^2]
+  std::vector<double> lambdaGrid(int count) const;
+  // Write GCV scores of lambdas into scores, returns the index of the minimum
+  int gcvCurve(const std::vector<double> &lambdas,
+               std::vector<double> *scores) const;
+  // Lambda minimizing GCV over lambdaGrid(count)
+  double bestLambda(int count = 64) const;
+
+ private:
+  Curve domain_;
+  Eigen::MatrixXd V_;
+  Eigen::VectorXd s_;     // singular values
+  Eigen::VectorXd beta_;  // U^T y
+  int order_;
+  double outside2_;  // |y|^2 - |U^T y|^2, residual outside the column space
+  size_t n_;
+};
+
+}  // namespace curvefit
+
+#endif  // CURVEFIT_LEAST_SQUARES_H
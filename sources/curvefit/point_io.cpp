@@ -0,0 +1,194 @@
+#include "point_io.h"
+
+#include <cstring>  // Required for: memchr(), strcmp(), strrchr()
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace curvefit {
+
+#if defined(_WIN32)
+bool MappedFile::open(const char *path) {
+  close();
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  const void *view =
+      mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!view) {
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+  file_ = file;
+  mapping_ = mapping;
+  data_ = (const char *)view;
+  size_ = (size_t)size.QuadPart;
+  return true;
+}
+
+void MappedFile::close() {
+  if (data_) UnmapViewOfFile(data_);
+  if (mapping_) CloseHandle((HANDLE)mapping_);
+  if (file_) CloseHandle((HANDLE)file_);
+  data_ = nullptr;
+  size_ = 0;
+  file_ = mapping_ = nullptr;
+}
+#else
+bool MappedFile::open(const char *path) {
+  close();
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+  void *view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);  // the mapping keeps the file alive
+  if (view == MAP_FAILED) return false;
+  madvise(view, (size_t)st.st_size, MADV_SEQUENTIAL);
+  data_ = (const char *)view;
+  size_ = (size_t)st.st_size;
+  return true;
+}
+
+void MappedFile::close() {
+  if (data_) munmap((void *)data_, size_);
+  data_ = nullptr;
+  size_ = 0;
+}
+#endif
+
+void PointFile::clear() {
+  file_.close();
+  parsed_.clear();
+  xy_ = nullptr;
+  size_ = 0;
+}
+
+bool PointFile::load(const char *path) {
+  const char *ext = strrchr(path, '.');
+  if (ext && (strcmp(ext, ".csv") == 0 || strcmp(ext, ".CSV") == 0 ||
+              strcmp(ext, ".txt") == 0 || strcmp(ext, ".TXT") == 0)) {
+    return loadCsv(path);
+  }
+  return loadBinary(path);
+}
+
+bool PointFile::loadBinary(const char *path) {
+  clear();
+  if (!file_.open(path)) return false;
+  if (file_.size() % (2 * sizeof(float)) != 0) {
+    clear();
+    return false;
+  }
+  // the mapping is page aligned, so the floats are too
+  xy_ = (const float *)file_.data();
+  size_ = file_.size() / (2 * sizeof(float));
+  return true;
+}
+
+// Decimal number at p, without the locale lookups and terminator strtod
+// needs; the mapped file is not null terminated
+static bool parseNumber(const char *&p, const char *end, float *value) {
+  const char *s = p;
+  bool negative = false;
+  if (s < end && (*s == '-' || *s == '+')) negative = *s++ == '-';
+
+  double mantissa = 0;
+  int exponent = 0, digits = 0;
+  for (; s < end && *s >= '0' && *s <= '9'; s++, digits++) {
+    mantissa = mantissa * 10 + (*s - '0');
+  }
+  if (s < end && *s == '.') {
+    for (s++; s < end && *s >= '0' && *s <= '9'; s++, digits++) {
+      mantissa = mantissa * 10 + (*s - '0');
+      exponent--;
+    }
+  }
+  if (digits == 0) return false;
+  if (s < end && (*s == 'e' || *s == 'E')) {
+    const char *e = s + 1;
+    bool negativeExp = false;
+    if (e < end && (*e == '-' || *e == '+')) negativeExp = *e++ == '-';
+    if (e < end && *e >= '0' && *e <= '9') {
+      int n = 0;
+      for (; e < end && *e >= '0' && *e <= '9'; e++) {
+        if (n < 1000) n = n * 10 + (*e - '0');
+      }
+      exponent += negativeExp ? -n : n;
+      s = e;
+    }
+  }
+
+  static const double POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                 1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16};
+  while (exponent > 16) {
+    mantissa *= 1e16;
+    exponent -= 16;
+  }
+  while (exponent < -16) {
+    mantissa /= 1e16;
+    exponent += 16;
+  }
+  mantissa = exponent < 0 ? mantissa / POW10[-exponent]
+                          : mantissa * POW10[exponent];
+  *value = (float)(negative ? -mantissa : mantissa);
+  p = s;
+  return true;
+}
+
+static const char *skipSeparators(const char *p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == ',' || *p == ';')) p++;
+  return p;
+}
+
+bool PointFile::loadCsv(const char *path) {
+  clear();
+  MappedFile text;
+  if (!text.open(path)) return false;
+
+  const char *p = text.data();
+  const char *end = p + text.size();
+  // two floats per line, about 10 characters each
+  parsed_.reserve(text.size() / 10);
+  while (p < end) {
+    const char *eol = (const char *)memchr(p, '\n', end - p);
+    if (!eol) eol = end;
+    float x, y;
+    const char *s = skipSeparators(p, eol);
+    if (parseNumber(s, eol, &x)) {
+      s = skipSeparators(s, eol);
+      if (parseNumber(s, eol, &y)) {
+        parsed_.push_back(x);
+        parsed_.push_back(y);
+      }
+    }
+    p = eol + 1;
+  }
+  parsed_.shrink_to_fit();
+
+  xy_ = parsed_.data();
+  size_ = parsed_.size() / 2;
+  return size_ > 0;
+}
+
+}  // namespace curvefit
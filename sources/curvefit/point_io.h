@@ -0,0 +1,64 @@
+// Point import from files
+//
+// Binary files are packed little-endian float32 [x0, y0, x1, y1, ...] pairs.
+// They are memory-mapped and viewed in place, so opening one costs a page
+// table update instead of a read and a copy. CSV files hold one "x,y" pair
+// per line (comma, semicolon, tab or space separated); lines that do not
+// start with two numbers, like a header, are skipped.
+#ifndef CURVEFIT_POINT_IO_H
+#define CURVEFIT_POINT_IO_H
+
+#include <cstddef>
+#include <vector>
+
+#include "curvefit.h"
+
+namespace curvefit {
+
+// Read-only mapping of a whole file
+class MappedFile {
+ public:
+  MappedFile() {}
+  ~MappedFile() { close(); }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool open(const char *path);
+  void close();
+
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+#if defined(_WIN32)
+  void *file_ = nullptr;     // HANDLE
+  void *mapping_ = nullptr;  // HANDLE
+#endif
+};
+
+// Points of one file, valid until the next load or destruction
+class PointFile {
+ public:
+  // Load by extension: .csv and .txt are parsed, anything else is binary
+  bool load(const char *path);
+  bool loadBinary(const char *path);
+  bool loadCsv(const char *path);
+  void clear();
+
+  // Interleaved x/y, layout compatible with an array of raylib Vector2
+  const float *xy() const { return xy_; }
+  size_t size() const { return size_; }
+  PointSpan span() const { return interleavedSpan(xy_, size_); }
+
+ private:
+  MappedFile file_;
+  std::vector<float> parsed_;  // CSV values, binary files stay in file_
+  const float *xy_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace curvefit
+
+#endif  // CURVEFIT_POINT_IO_H
@@ -0,0 +1,106 @@
+#include "sampling.h"
+
+#include <algorithm>  // Required for: std::min(), std::max()
+#include <cmath>      // Required for: ceil(), fabs(), sqrt()
+
+namespace curvefit {
+
+using Eigen::ArrayXd;
+
+// Levels of splitting, each level quarters the segments it splits
+static const int MAX_SPLIT_LEVELS = 12;
+
+// Distance of (mx, my) from the segment (x0, y0) - (x1, y1)
+static double chordDistance(double x0, double y0, double x1, double y1,
+                            double mx, double my) {
+  double dx = x1 - x0, dy = y1 - y0;
+  double length = sqrt(dx * dx + dy * dy);
+  if (length == 0) return sqrt((mx - x0) * (mx - x0) + (my - y0) * (my - y0));
+  return fabs(dx * (my - y0) - dy * (mx - x0)) / length;
+}
+
+void sampleAdaptive(const Curve &curve, const AdaptiveSampling &spec,
+                    std::vector<double> *xs, std::vector<double> *ys) {
+  xs->clear();
+  ys->clear();
+  if (curve.empty()) return;
+
+  double x0 = std::max(spec.x0, curve.xMin);
+  double x1 = std::min(spec.x1, curve.xMax);
+  if (x0 > x1) return;
+
+  // initial uniform segments, evaluated in one batch
+  int segments = 1;
+  if (spec.maxStep > 0) {
+    segments = std::max(1, (int)ceil((x1 - x0) / spec.maxStep));
+  }
+  ArrayXd x = ArrayXd::LinSpaced(segments + 1, x0, x1), y;
+  evaluate(curve, x, &y);
+  xs->assign(x.data(), x.data() + x.size());
+  ys->assign(y.data(), y.data() + y.size());
+  std::vector<char> open(segments, 1);  // segment i = [i, i + 1] is tested
+
+  std::vector<double> nextX, nextY;
+  std::vector<char> nextOpen;
+  std::vector<int> tested;
+  ArrayXd mx, my;
+  for (int level = 0; level < MAX_SPLIT_LEVELS; level++) {
+    // open segments wide enough to split, evaluated in one batch
+    tested.clear();
+    for (size_t i = 0; i + 1 < xs->size(); i++) {
+      if (open[i] && (*xs)[i + 1] - (*xs)[i] > spec.minStep) {
+        tested.push_back((int)i);
+      }
+    }
+    if (tested.empty()) break;
+
+    // quarter points and midpoint of every tested segment; testing only the
+    // midpoint misses curves crossing the segment at its center
+    mx.resize(3 * tested.size());
+    for (size_t k = 0; k < tested.size(); k++) {
+      double a = (*xs)[tested[k]], b = (*xs)[tested[k] + 1];
+      for (int q = 0; q < 3; q++) mx(3 * k + q) = a + (b - a) * (q + 1) / 4;
+    }
+    evaluate(curve, mx, &my);
+
+    // segments within tolerance are final, the others are split into
+    // quarters which stay open
+    nextX.clear();
+    nextY.clear();
+    nextOpen.clear();
+    size_t k = 0;
+    for (size_t i = 0; i + 1 < xs->size(); i++) {
+      nextX.push_back((*xs)[i]);
+      nextY.push_back((*ys)[i]);
+      if (k < tested.size() && tested[k] == (int)i) {
+        double error = 0;
+        for (int q = 0; q < 3; q++) {
+          error = std::max(error, chordDistance((*xs)[i], (*ys)[i],
+                                                (*xs)[i + 1], (*ys)[i + 1],
+                                                mx(3 * k + q), my(3 * k + q)));
+        }
+        if (error > spec.tolerance) {
+          nextOpen.push_back(1);
+          for (int q = 0; q < 3; q++) {
+            nextX.push_back(mx(3 * k + q));
+            nextY.push_back(my(3 * k + q));
+            nextOpen.push_back(1);
+          }
+        } else {
+          nextOpen.push_back(0);
+        }
+        k++;
+      } else {
+        nextOpen.push_back(0);
+      }
+    }
+    nextX.push_back(xs->back());
+    nextY.push_back(ys->back());
+
+    xs->swap(nextX);
+    ys->swap(nextY);
+    open.swap(nextOpen);
+  }
+}
+
+}  // namespace curvefit
@@ -0,0 +1,40 @@
+// Adaptive curve sampling
+//
+// Segments of the sampled polyline are split into quarters until the curve
+// is within tolerance of the segment, so flat parts get few samples and
+// oscillating parts many. With tolerance and steps given in world units of
+// one screen pixel divided by the camera zoom, the sample count follows what
+// is visible instead of the x range of the data.
+#ifndef CURVEFIT_SAMPLING_H
+#define CURVEFIT_SAMPLING_H
+
+#include <cmath>  // Required for: INFINITY
+#include <vector>
+
+#include "curvefit.h"
+
+namespace curvefit {
+
+struct AdaptiveSampling {
+  double x0, x1;     // range to sample, clipped to [curve.xMin, curve.xMax]
+  double tolerance;  // max distance between the curve and a segment
+  double minStep;    // segments narrower than this are not split
+  double maxStep;    // width of the initial segments
+
+  AdaptiveSampling()
+      : x0(-INFINITY), x1(INFINITY), tolerance(0.25), minStep(0.5),
+        maxStep(32) {}
+};
+
+inline bool operator==(const AdaptiveSampling &a, const AdaptiveSampling &b) {
+  return a.x0 == b.x0 && a.x1 == b.x1 && a.tolerance == b.tolerance &&
+         a.minStep == b.minStep && a.maxStep == b.maxStep;
+}
+
+// Samples sorted by x, both ends of the clipped range included
+void sampleAdaptive(const Curve &curve, const AdaptiveSampling &spec,
+                    std::vector<double> *xs, std::vector<double> *ys);
+
+}  // namespace curvefit
+
+#endif  // CURVEFIT_SAMPLING_H
@@ -0,0 +1,316 @@
+#include "solver.h"
+
+#include <algorithm>  // Required for: std::min()
+#include <cmath>      // Required for: sqrt(), INFINITY
+
+namespace curvefit {
+
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+// normal equations keep about 6 of the 16 digits at this rcond
+static const double RCOND_NORMAL = 1e-10;
+static const double RCOND_LU = 1e-12;
+// float32 refinement needs cond * 2^-24 well below 1
+static const double RCOND_MIXED = 1e-5;
+static const int MAX_REFINEMENT = 10;
+// converged once a correction is this small relative to the solution
+static const double REFINEMENT_TOL = 1e-12;
+
+const char *solverName(SolverType solver) {
+  switch (solver) {
+    case SOLVER_AUTO: return "AUTO";
+    case SOLVER_LLT: return "LLT";
+    case SOLVER_LDLT: return "LDLT";
+    case SOLVER_QR: return "QR";
+    case SOLVER_SVD: return "SVD";
+    case SOLVER_LU: return "LU";
+  }
+  return "UNKNOWN";
+}
+
+// Lower triangle of A^T A + diag(ridge)
+static MatrixXd normalMatrix(const MatrixXd &A, const VectorXd &ridge) {
+  MatrixXd G = MatrixXd::Zero(A.cols(), A.cols());
+  G.selfadjointView<Eigen::Lower>().rankUpdate(A.transpose());
+  G.diagonal() += ridge;
+  return G;
+}
+
+// Column pivoting QR, on [A; diag(sqrt(ridge))] x = [y; 0] when regularized
+static VectorXd solveQr(const MatrixXd &A, const VectorXd &y,
+                        const VectorXd &ridge, bool *rankDeficient) {
+  Eigen::ColPivHouseholderQR<MatrixXd> qr;
+  if (ridge.any()) {
+    Eigen::Index m = A.cols();
+    MatrixXd augmented(A.rows() + m, m);
+    augmented << A, MatrixXd(ridge.cwiseSqrt().asDiagonal());
+    VectorXd rhs(A.rows() + m);
+    rhs << y, VectorXd::Zero(m);
+    qr.compute(augmented);
+    *rankDeficient = qr.rank() < m;
+    return qr.solve(rhs);
+  }
+  qr.compute(A);
+  *rankDeficient = qr.rank() < A.cols();
+  return qr.solve(y);
+}
+
+// Minimum norm solution, singular values filtered by s / (s^2 + lambda)
+static VectorXd solveSvd(const MatrixXd &A, const VectorXd &y,
+                         double lambda) {
+  Eigen::BDCSVD<MatrixXd> svd(A, Eigen::ComputeThinU | Eigen::ComputeThinV);
+  if (lambda <= 0) return svd.solve(y);
+  const VectorXd &s = svd.singularValues();
+  VectorXd beta = svd.matrixU().transpose() * y;
+  return svd.matrixV() *
+         (s.array() / (s.array().square() + lambda) * beta.array()).matrix();
+}
+
+// Solve with the columns of A scaled to unit norm, x = D z for
+// min |A D z - y|^2 + lambda |D z|^2. Power basis columns span many orders
+// of magnitude; unscaled, the rank and condition tests would mistake that
+// for rank deficiency.
+static SolverType solveScaled(const MatrixXd &A, const VectorXd &y,
+                              double lambda, SolverType solver, VectorXd *x) {
+  VectorXd d = A.colwise().norm().transpose();
+  for (Eigen::Index j = 0; j < d.size(); j++) d(j) = d(j) > 0 ? 1 / d(j) : 1;
+  MatrixXd As = A * d.asDiagonal();
+  VectorXd ridge = lambda * d.array().square().matrix();
+
+  bool square = A.rows() == A.cols() && lambda <= 0;
+  bool rankDeficient = false;
+  VectorXd z;
+  SolverType used = solver;
+
+  if (solver == SOLVER_AUTO) {
+    used = SOLVER_QR;
+    if (square) {
+      Eigen::PartialPivLU<MatrixXd> lu(As);
+      if (lu.rcond() >= RCOND_LU) {
+        z = lu.solve(y);
+        used = SOLVER_LU;
+      }
+    } else {
+      Eigen::LLT<MatrixXd, Eigen::Lower> llt(normalMatrix(As, ridge));
+      if (llt.info() == Eigen::Success && llt.rcond() >= RCOND_NORMAL) {
+        z = llt.solve(As.transpose() * y);
+        used = SOLVER_LLT;
+      }
+    }
+    if (used == SOLVER_QR) {
+      z = solveQr(As, y, ridge, &rankDeficient);
+      if (rankDeficient) {
+        if (lambda > 0) return solveScaled(A, y, lambda, SOLVER_SVD, x);
+        z = solveSvd(As, y, 0);
+        used = SOLVER_SVD;
+      }
+    }
+  } else if (solver == SOLVER_LLT || solver == SOLVER_LDLT) {
+    MatrixXd G = normalMatrix(As, ridge);
+    Eigen::LLT<MatrixXd, Eigen::Lower> llt;
+    if (solver == SOLVER_LLT) llt.compute(G);
+    if (solver == SOLVER_LLT && llt.info() == Eigen::Success) {
+      z = llt.solve(As.transpose() * y);
+    } else {
+      // not numerically positive definite, the pivoting LDLT still works
+      z = Eigen::LDLT<MatrixXd, Eigen::Lower>(G).solve(As.transpose() * y);
+      used = SOLVER_LDLT;
+    }
+  } else if (solver == SOLVER_LU) {
+    if (square) {
+      z = As.partialPivLu().solve(y);
+    } else {
+      MatrixXd G = normalMatrix(As, ridge).selfadjointView<Eigen::Lower>();
+      z = G.partialPivLu().solve(As.transpose() * y);
+    }
+  } else if (solver == SOLVER_QR) {
+    z = solveQr(As, y, ridge, &rankDeficient);
+  } else {
+    // the filter factors need the unscaled singular values
+    if (lambda > 0) {
+      *x = solveSvd(A, y, lambda);
+      return SOLVER_SVD;
+    }
+    z = solveSvd(As, y, 0);
+    used = SOLVER_SVD;
+  }
+
+  *x = d.asDiagonal() * z;
+  return used;
+}
+
+SolverType solveLeastSquares(const MatrixXd &A, const VectorXd &y,
+                             double lambda, SolverType solver, VectorXd *x) {
+  return solveScaled(A, y, lambda, solver, x);
+}
+
+SolverType solveSymmetric(const MatrixXd &K, const MatrixXd &rhs,
+                          SolverType solver, MatrixXd *x) {
+  if (solver == SOLVER_AUTO || solver == SOLVER_LLT) {
+    // blocked Cholesky, several times faster than the pivoting LDLT
+    Eigen::LLT<MatrixXd, Eigen::Lower> llt(K);
+    if (llt.info() == Eigen::Success) {
+      *x = llt.solve(rhs);
+      return SOLVER_LLT;
+    }
+    solver = SOLVER_LDLT;
+  }
+  if (solver == SOLVER_LDLT) {
+    *x = Eigen::LDLT<MatrixXd, Eigen::Lower>(K).solve(rhs);
+    return SOLVER_LDLT;
+  }
+
+  MatrixXd full = K.selfadjointView<Eigen::Lower>();
+  if (solver == SOLVER_LU) {
+    *x = full.partialPivLu().solve(rhs);
+  } else if (solver == SOLVER_QR) {
+    *x = full.colPivHouseholderQr().solve(rhs);
+  } else {
+    *x = full.bdcSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(rhs);
+  }
+  return solver;
+}
+
+// Iterate x += d * correct(residual(x)) until the correction is negligible,
+// false when it stops shrinking first
+template <class Residual, class Correct>
+static bool refine(const VectorXd &d, Residual residual, Correct correct,
+                   VectorXd *x) {
+  double previous = INFINITY;
+  for (int k = 0; k < MAX_REFINEMENT; k++) {
+    VectorXd dz = correct(residual(*x));
+    if (!dz.allFinite()) return false;
+    *x += d.asDiagonal() * dz;
+    double size = dz.cwiseAbs().maxCoeff();
+    double scale = (d.cwiseInverse().asDiagonal() * *x).cwiseAbs().maxCoeff();
+    if (size <= REFINEMENT_TOL * scale) return true;
+    if (size > 0.5 * previous) return false;
+    previous = size;
+  }
+  return false;
+}
+
+bool solveLeastSquaresMixed(Eigen::Index rows, Eigen::Index cols,
+                            const RowFunction &row, const VectorXd &y,
+                            double lambda, SolverType solver, VectorXd *x,
+                            SolverType *used) {
+  if (solver == SOLVER_QR || solver == SOLVER_SVD) return false;
+  bool square = rows == cols && lambda <= 0;
+  if (solver == SOLVER_AUTO) solver = square ? SOLVER_LU : SOLVER_LLT;
+
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+                        Eigen::RowMajor>
+      RowBlock;
+  const Eigen::Index BLOCK = 256;
+  RowBlock block(BLOCK, cols);
+
+  // assemble in float, with the column norms for scaling and A^T y for the
+  // first residual in double
+  Eigen::MatrixXf Af(rows, cols);
+  VectorXd d = VectorXd::Zero(cols);
+  VectorXd aty = VectorXd::Zero(cols);
+  for (Eigen::Index i = 0; i < rows; i += BLOCK) {
+    Eigen::Index m = std::min(BLOCK, rows - i);
+    row(i, m, block.data());
+    auto b = block.topRows(m);
+    Af.middleRows(i, m) = b.cast<float>();
+    d += b.colwise().squaredNorm().transpose();
+    aty.noalias() += b.transpose() * y.segment(i, m);
+  }
+  for (Eigen::Index j = 0; j < cols; j++) {
+    d(j) = d(j) > 0 ? 1 / sqrt(d(j)) : 1;
+  }
+  Af = Af * d.cast<float>().asDiagonal();
+
+  // r = y - A x, and the normal residual d * (A^T r - lambda x)
+  VectorXd r(rows), g(cols);
+  bool first = true;
+  auto residual = [&](const VectorXd &xs) -> const VectorXd & {
+    if (first && !square) {
+      first = false;  // x = 0
+      g = d.asDiagonal() * aty;
+      return g;
+    }
+    g.setZero();
+    for (Eigen::Index i = 0; i < rows; i += BLOCK) {
+      Eigen::Index m = std::min(BLOCK, rows - i);
+      row(i, m, block.data());
+      auto b = block.topRows(m);
+      r.segment(i, m) = y.segment(i, m) - b * xs;
+      if (!square) g.noalias() += b.transpose() * r.segment(i, m);
+    }
+    if (square) return r;
+    g = d.asDiagonal() * (g - lambda * xs);
+    return g;
+  };
+
+  bool converged = false;
+  if (square && solver == SOLVER_LU) {
+    Eigen::PartialPivLU<Eigen::MatrixXf> lu(Af);
+    if (lu.rcond() < RCOND_MIXED) return false;
+    auto correct = [&](const VectorXd &res) -> VectorXd {
+      return lu.solve(res.cast<float>()).cast<double>();
+    };
+    *x = VectorXd::Zero(cols);
+    converged = refine(d, residual, correct, x);
+  } else {
+    Eigen::MatrixXf Gf = Eigen::MatrixXf::Zero(cols, cols);
+    Gf.selfadjointView<Eigen::Lower>().rankUpdate(Af.transpose());
+    Gf.diagonal() += (lambda * d.array().square()).matrix().cast<float>();
+    *x = VectorXd::Zero(cols);
+    if (solver == SOLVER_LLT) {
+      Eigen::LLT<Eigen::MatrixXf, Eigen::Lower> llt(Gf);
+      if (llt.info() != Eigen::Success || llt.rcond() < RCOND_MIXED) {
+        return false;
+      }
+      auto correct = [&](const VectorXd &res) -> VectorXd {
+        return llt.solve(res.cast<float>()).cast<double>();
+      };
+      converged = refine(d, residual, correct, x);
+    } else if (solver == SOLVER_LDLT) {
+      Eigen::LDLT<Eigen::MatrixXf, Eigen::Lower> ldlt(Gf);
+      auto correct = [&](const VectorXd &res) -> VectorXd {
+        return ldlt.solve(res.cast<float>()).cast<double>();
+      };
+      converged = refine(d, residual, correct, x);
+    } else {
+      Eigen::MatrixXf G = Gf.selfadjointView<Eigen::Lower>();
+      Eigen::PartialPivLU<Eigen::MatrixXf> lu(G);
+      auto correct = [&](const VectorXd &res) -> VectorXd {
+        return lu.solve(res.cast<float>()).cast<double>();
+      };
+      converged = refine(d, residual, correct, x);
+    }
+  }
+  *used = solver;
+  return converged;
+}
+
+bool solveSymmetricMixed(const MatrixXd &K, const MatrixXd &rhs,
+                         SolverType solver, MatrixXd *x, SolverType *used) {
+  if (solver != SOLVER_AUTO && solver != SOLVER_LLT) return false;
+  // the upper triangle of K may be uninitialized, never read it
+  Eigen::MatrixXf Kf = Eigen::MatrixXf::Zero(K.rows(), K.cols());
+  Kf.triangularView<Eigen::Lower>() = K.cast<float>();
+  Eigen::LLT<Eigen::MatrixXf, Eigen::Lower> llt(Kf);
+  if (llt.info() != Eigen::Success || llt.rcond() < RCOND_MIXED) return false;
+
+  VectorXd d = VectorXd::Ones(K.rows());
+  x->resize(K.rows(), rhs.cols());
+  for (Eigen::Index c = 0; c < rhs.cols(); c++) {
+    auto residual = [&](const VectorXd &xs) -> VectorXd {
+      return rhs.col(c) - K.selfadjointView<Eigen::Lower>() * xs;
+    };
+    auto correct = [&](const VectorXd &res) -> VectorXd {
+      return llt.solve(res.cast<float>()).cast<double>();
+    };
+    VectorXd xc = VectorXd::Zero(K.rows());
+    if (!refine(d, residual, correct, &xc)) return false;
+    x->col(c) = xc;
+  }
+  *used = SOLVER_LLT;
+  return true;
+}
+
+}  // namespace curvefit
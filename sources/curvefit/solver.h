@@ -0,0 +1,62 @@
+// Dense solver selection
+//
+// The fitting modes reduce to min |A x - y|^2 + lambda |x|^2 (lambda = 0 for
+// interpolation and least squares). SOLVER_AUTO picks the cheapest
+// decomposition that is accurate enough for the problem at hand:
+//   - square systems: LU, if its condition estimate is acceptable
+//   - tall systems: LLT of A^T A + lambda I, n*order^2 flops, if the normal
+//     equations are well conditioned, as they lose -log10(rcond) digits
+//   - otherwise column pivoting QR of A, 2*n*order^2 flops
+//   - and the SVD only when QR finds A rank deficient
+// Condition numbers are LAPACK style 1-norm estimates from the factors
+// themselves, O(order^2) on top of the factorization.
+#ifndef CURVEFIT_SOLVER_H
+#define CURVEFIT_SOLVER_H
+
+#include <functional>
+
+#include "curvefit.h"
+
+namespace curvefit {
+
+// Fills rows [first, first + count) of A in double, row-major with cols
+// values per row
+typedef std::function<void(Eigen::Index first, Eigen::Index count,
+                           double *rows)>
+    RowFunction;
+
+// Name for menus and reports, e.g. "LLT"
+const char *solverName(SolverType solver);
+
+// Solve the regularized least squares problem above into x, returns the
+// solver that was actually used
+SolverType solveLeastSquares(const Eigen::MatrixXd &A, const Eigen::VectorXd &y,
+                             double lambda, SolverType solver,
+                             Eigen::VectorXd *x);
+
+// Solve K x = rhs for symmetric positive (semi)definite K, only the lower
+// triangle of K is read. AUTO uses LLT and falls back to LDLT.
+SolverType solveSymmetric(const Eigen::MatrixXd &K, const Eigen::MatrixXd &rhs,
+                          SolverType solver, Eigen::MatrixXd *x);
+
+// Mixed precision variants: the matrix is stored and factorized in float32,
+// half the memory traffic and twice the SIMD width, and the solution is
+// then refined with residuals computed in double until it reaches double
+// accuracy. Refinement converges when cond * 1e-7 is well below 1; false if
+// it did not, or the solver has no float path (QR/SVD), and the caller
+// should use the double solvers above.
+//
+// A is never held in double, the refinement regenerates its rows a block at
+// a time. solveSymmetricMixed, like solveSymmetric, only reads the lower
+// triangle of K. Both report the factorization they used in *used.
+bool solveLeastSquaresMixed(Eigen::Index rows, Eigen::Index cols,
+                            const RowFunction &row, const Eigen::VectorXd &y,
+                            double lambda, SolverType solver,
+                            Eigen::VectorXd *x, SolverType *used);
+bool solveSymmetricMixed(const Eigen::MatrixXd &K, const Eigen::MatrixXd &rhs,
+                         SolverType solver, Eigen::MatrixXd *x,
+                         SolverType *used);
+
+}  // namespace curvefit
+
+#endif  // CURVEFIT_SOLVER_H
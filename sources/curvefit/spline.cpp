@@ -0,0 +1,249 @@
+#include "spline.h"
+
+#include <algorithm>  // Required for: std::sort(), std::upper_bound()
+#include <cmath>      // Required for: fabs()
+#include <cstddef>    // Required for: ptrdiff_t
+#include <numeric>    // Required for: std::iota()
+
+namespace curvefit {
+
+// Append (x, y) to xs/ys, or average y into the last point for equal x
+static void appendPoint(double x, double y, std::vector<double> *xs,
+                        std::vector<double> *ys, int *count) {
+  if (!xs->empty() && x == xs->back()) {
+    (*count)++;
+    ys->back() += (y - ys->back()) / *count;
+  } else {
+    xs->push_back(x);
+    ys->push_back(y);
+    *count = 1;
+  }
+}
+
+// Points sorted by x with duplicates merged, skips the sort and the index
+// array for data that is already in order (imported traces usually are)
+static void sortedPoints(PointSpan points, std::vector<double> *xs,
+                         std::vector<double> *ys) {
+  size_t n = points.size;
+  bool sorted = true;
+  for (size_t i = 1; i < n && sorted; i++) {
+    sorted = points.X(i - 1) <= points.X(i);
+  }
+
+  xs->clear();
+  ys->clear();
+  xs->reserve(n);
+  ys->reserve(n);
+  int count = 0;
+  if (sorted) {
+    for (size_t i = 0; i < n; i++) {
+      appendPoint(points.X(i), points.Y(i), xs, ys, &count);
+    }
+    return;
+  }
+
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&points](size_t a, size_t b) {
+    return points.X(a) < points.X(b);
+  });
+  for (size_t i = 0; i < n; i++) {
+    appendPoint(points.X(order[i]), points.Y(order[i]), xs, ys, &count);
+  }
+}
+
+// Symmetric tridiagonal solve, b[i] on the diagonal and e[i] beside it at
+// (i, i+1) and (i+1, i). LDL^T in place: b becomes D, the solution is left
+// in d[0 .. n).
+static void solveSymmetricTridiagonal(const std::vector<double> &e,
+                                      std::vector<double> *b, double *d) {
+  size_t n = b->size();
+  for (size_t i = 1; i < n; i++) {
+    double l = e[i - 1] / (*b)[i - 1];
+    (*b)[i] -= l * e[i - 1];
+    d[i] -= l * d[i - 1];
+  }
+  d[n - 1] /= (*b)[n - 1];
+  for (size_t i = n - 1; i-- > 0;) d[i] = (d[i] - e[i] * d[i + 1]) / (*b)[i];
+}
+
+// Thomas algorithm for a[i] x[i-1] + b[i] x[i] + c[i] x[i+1] = d[i], a[0]
+// and c[n-1] unused. Overwrites c and d, the solution is left in d.
+static void solveTridiagonal(const std::vector<double> &a,
+                             const std::vector<double> &b,
+                             std::vector<double> *c, std::vector<double> *d) {
+  size_t n = b.size();
+  (*c)[0] /= b[0];
+  (*d)[0] /= b[0];
+  for (size_t i = 1; i < n; i++) {
+    double m = 1 / (b[i] - a[i] * (*c)[i - 1]);
+    if (i + 1 < n) (*c)[i] *= m;
+    (*d)[i] = ((*d)[i] - a[i] * (*d)[i - 1]) * m;
+  }
+  for (size_t i = n - 1; i-- > 0;) (*d)[i] -= (*c)[i] * (*d)[i + 1];
+}
+
+// Index i of the interval [knots[i], knots[i+1]] holding x, clamped to the
+// first and last interval of knots[first .. last]
+static size_t findInterval(const std::vector<double> &knots, size_t first,
+                           size_t last, double x) {
+  size_t i = std::upper_bound(knots.begin() + first, knots.begin() + last, x) -
+             knots.begin();
+  return i <= first ? first : i - 1;
+}
+
+Curve fitCubicSpline(PointSpan points, bool clamped) {
+  Curve curve;
+  std::vector<double> xs, ys;
+  sortedPoints(points, &xs, &ys);
+  size_t n = xs.size();
+  if (n < 2) return curve;
+
+  std::vector<double> h(n - 1);
+  for (size_t i = 0; i + 1 < n; i++) h[i] = xs[i + 1] - xs[i];
+
+  // h_i-1 M_i-1 + 2 (h_i-1 + h_i) M_i + h_i M_i+1 = 6 (s_i - s_i-1), the
+  // matrix is symmetric with h beside the diagonal. M is solved straight
+  // into the second half of alpha.
+  curve.alpha.resize(2 * n);
+  double *d = curve.alpha.data() + n;
+  std::vector<double> b(n);
+  for (size_t i = 1; i + 1 < n; i++) {
+    b[i] = 2 * (h[i - 1] + h[i]);
+    d[i] = 6 * ((ys[i + 1] - ys[i]) / h[i] - (ys[i] - ys[i - 1]) / h[i - 1]);
+  }
+  if (clamped) {
+    // end slopes of the parabolas through the first and last three points
+    double s0 = (ys[1] - ys[0]) / h[0];
+    double s1 = (ys[n - 1] - ys[n - 2]) / h[n - 2];
+    if (n > 2) {
+      double t0 = (ys[2] - ys[1]) / h[1];
+      s0 = s0 - (t0 - s0) * h[0] / (h[0] + h[1]);
+      double t1 = (ys[n - 2] - ys[n - 3]) / h[n - 3];
+      s1 = s1 + (s1 - t1) * h[n - 2] / (h[n - 3] + h[n - 2]);
+    }
+    b[0] = 2 * h[0];
+    d[0] = 6 * ((ys[1] - ys[0]) / h[0] - s0);
+    b[n - 1] = 2 * h[n - 2];
+    d[n - 1] = 6 * (s1 - (ys[n - 1] - ys[n - 2]) / h[n - 2]);
+  } else {
+    // natural ends M_0 = M_n-1 = 0, decoupled from the interior rows since
+    // the coupling terms vanish anyway
+    b[0] = b[n - 1] = 1;
+    d[0] = d[n - 1] = 0;
+    h.front() = h.back() = 0;
+  }
+  solveSymmetricTridiagonal(h, &b, d);
+
+  curve.basis = BASIS_CUBIC_SPLINE;
+  for (size_t i = 0; i < n; i++) curve.alpha(i) = ys[i];
+  curve.xMin = xs.front();
+  curve.xMax = xs.back();
+  curve.centers.swap(xs);
+  return curve;
+}
+
+double evaluateCubicSpline(const Curve &curve, double x) {
+  const std::vector<double> &xs = curve.centers;
+  size_t n = xs.size();
+  size_t i = findInterval(xs, 0, n - 1, x);
+  double h = xs[i + 1] - xs[i];
+  double l = xs[i + 1] - x, r = x - xs[i];
+  double m0 = curve.alpha(n + i), m1 = curve.alpha(n + i + 1);
+  return (m0 * l * l * l + m1 * r * r * r) / (6 * h) +
+         (curve.alpha(i) / h - m0 * h / 6) * l +
+         (curve.alpha(i + 1) / h - m1 * h / 6) * r;
+}
+
+// The four cubic B-splines N_s-3 .. N_s that are nonzero on the knot span
+// [t[s], t[s+1]], Cox-de Boor recursion
+static void bsplineBasis(const double *t, size_t s, double x, double N[4]) {
+  double left[4], right[4];
+  N[0] = 1;
+  for (int j = 1; j <= 3; j++) {
+    left[j] = x - t[s + 1 - j];
+    right[j] = t[s + j] - x;
+    double saved = 0;
+    for (int r = 0; r < j; r++) {
+      double temp = N[r] / (right[r + 1] + left[j - r]);
+      N[r] = saved + right[r + 1] * temp;
+      saved = left[j - r] * temp;
+    }
+    N[j] = saved;
+  }
+}
+
+Curve fitBSpline(PointSpan points) {
+  Curve curve;
+  std::vector<double> xs, ys;
+  sortedPoints(points, &xs, &ys);
+  size_t n = xs.size();
+  if (n < 2) return curve;
+
+  // knots t_-3 .. t_n+2 stored from index 0, so t_k is knots[k + 3]
+  std::vector<double> knots(n + 6);
+  double hFirst = xs[1] - xs[0], hLast = xs[n - 1] - xs[n - 2];
+  for (size_t i = 0; i < n; i++) knots[i + 3] = xs[i];
+  for (int k = 1; k <= 3; k++) {
+    knots[3 - k] = xs[0] - k * hFirst;
+    knots[n + 2 + k] = xs[n - 1] + k * hLast;
+  }
+  const double *t = knots.data() + 3;
+
+  bool uniform = true;
+  for (size_t i = 1; i + 1 < n && uniform; i++) {
+    uniform = fabs((xs[i + 1] - xs[i]) - hFirst) <= 1e-6 * hFirst;
+  }
+
+  // Row i interpolates y_i = N_i-3 c_i-3 + N_i-2 c_i-2 + N_i-1 c_i-1 at
+  // t_i, the unknowns are c_-2 .. c_n-3
+  std::vector<double> a(n), b(n), c(n), d;
+  d.swap(ys);
+  for (size_t i = 0; i < n; i++) {
+    if (uniform) {
+      a[i] = c[i] = 1.0 / 6;
+      b[i] = 4.0 / 6;
+    } else {
+      double N[4];
+      bsplineBasis(knots.data(), i + 3, xs[i], N);
+      a[i] = N[0];
+      b[i] = N[1];
+      c[i] = N[2];
+    }
+  }
+  // natural ends, S'' = 0 makes the derivative control points equal:
+  //   c_-3 = c_-2 + (c_-2 - c_-1) e0,      e0 = (t_1 - t_-2) / (t_2 - t_-1)
+  //   c_n-2 = c_n-3 + (c_n-3 - c_n-4) e1,  e1 = (t_n+1 - t_n-2) / (t_n - t_n-3)
+  double e0 = (t[1] - t[-2]) / (t[2] - t[-1]);
+  b[0] += a[0] * (1 + e0);
+  c[0] -= a[0] * e0;
+  ptrdiff_t m = (ptrdiff_t)n;
+  double e1 = (t[m + 1] - t[m - 2]) / (t[m] - t[m - 3]);
+  b[n - 1] += c[n - 1] * (1 + e1);
+  a[n - 1] -= c[n - 1] * e1;
+  solveTridiagonal(a, b, &c, &d);
+
+  curve.basis = BASIS_BSPLINE;
+  curve.alpha.resize(n + 2);
+  for (size_t i = 0; i < n; i++) curve.alpha(i + 1) = d[i];
+  curve.alpha(0) = d[0] + (d[0] - d[1]) * e0;
+  curve.alpha(n + 1) = d[n - 1] + (d[n - 1] - d[n - 2]) * e1;
+  curve.xMin = xs.front();
+  curve.xMax = xs.back();
+  curve.centers.swap(knots);
+  return curve;
+}
+
+double evaluateBSpline(const Curve &curve, double x) {
+  const std::vector<double> &knots = curve.centers;
+  size_t n = knots.size() - 6;
+  // span s of t, knots[s + 3]
+  size_t s = findInterval(knots, 3, n + 2, x) - 3;
+  double N[4];
+  bsplineBasis(knots.data(), s + 3, x, N);
+  // N_s-3 .. N_s are alpha(s) .. alpha(s + 3)
+  return N[0] * curve.alpha(s) + N[1] * curve.alpha(s + 1) +
+         N[2] * curve.alpha(s + 2) + N[3] * curve.alpha(s + 3);
+}
+
+}  // namespace curvefit
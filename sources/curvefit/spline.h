@@ -0,0 +1,33 @@
+// Piecewise cubic interpolation (FITTING_SIX/SEVEN/EIGHT)
+//
+// Splines only couple neighboring points, so their systems are tridiagonal
+// and the Thomas algorithm solves them in O(n), against the O(n^3) dense
+// solves of the global bases. Both forms interpolate the points sorted by
+// x; points sharing an x are merged into their mean y.
+//
+// Cubic splines store the knot values and second derivatives M_i:
+//   centers = x_i, alpha = [y_0 .. y_n-1, M_0 .. M_n-1]
+// Cubic B-splines store n + 2 control points over the data x used as knots,
+// extended by three knots of the end spacing on either side:
+//   centers = t_-3 .. t_n+2, alpha = c_-3 .. c_n-2
+#ifndef CURVEFIT_SPLINE_H
+#define CURVEFIT_SPLINE_H
+
+#include "curvefit.h"
+
+namespace curvefit {
+
+// Natural (M = 0 at the ends) or clamped cubic spline. Clamped end slopes
+// are those of the parabola through the three points at each end.
+Curve fitCubicSpline(PointSpan points, bool clamped);
+
+// Natural cubic B-spline with knots at the data x. Uniformly spaced x uses
+// the constant [1 4 1] / 6 system without evaluating the basis.
+Curve fitBSpline(PointSpan points);
+
+double evaluateCubicSpline(const Curve &curve, double x);
+double evaluateBSpline(const Curve &curve, double x);
+
+}  // namespace curvefit
+
+#endif  // CURVEFIT_SPLINE_H
@@ -0,0 +1,153 @@
+#include "batch_draw.h"
+
+#include <algorithm>  // Required for: std::min(), std::max()
+#include <cmath>      // Required for: sqrtf()
+
+#include "raymath.h"
+#include "rlgl.h"  // Required for: rl*()
+
+Rectangle cameraView(Camera2D camera, int screenWidth, int screenHeight) {
+  Vector2 corners[4] = {
+      GetScreenToWorld2D(Vector2{0, 0}, camera),
+      GetScreenToWorld2D(Vector2{(float)screenWidth, 0}, camera),
+      GetScreenToWorld2D(Vector2{0, (float)screenHeight}, camera),
+      GetScreenToWorld2D(Vector2{(float)screenWidth, (float)screenHeight},
+                         camera)};
+  Vector2 lo = corners[0], hi = corners[0];
+  for (int i = 1; i < 4; i++) {
+    lo.x = std::min(lo.x, corners[i].x);
+    lo.y = std::min(lo.y, corners[i].y);
+    hi.x = std::max(hi.x, corners[i].x);
+    hi.y = std::max(hi.y, corners[i].y);
+  }
+  return Rectangle{lo.x, lo.y, hi.x - lo.x, hi.y - lo.y};
+}
+
+// Segment bounding box, grown by margin, overlaps view
+static bool segmentVisible(Vector2 a, Vector2 b, float margin,
+                           Rectangle view) {
+  return std::max(a.x, b.x) + margin >= view.x &&
+         std::min(a.x, b.x) - margin <= view.x + view.width &&
+         std::max(a.y, b.y) + margin >= view.y &&
+         std::min(a.y, b.y) - margin <= view.y + view.height;
+}
+
+static Vector2 segmentNormal(Vector2 a, Vector2 b) {
+  Vector2 d = Vector2Subtract(b, a);
+  float length = sqrtf(d.x * d.x + d.y * d.y);
+  if (length == 0) return Vector2{0, 0};
+  return Vector2{-d.y / length, d.x / length};
+}
+
+// Append the strip vertex pair of points[i] for the run [first, last]
+static void appendJoin(const Vector2 *points, size_t i, size_t first,
+                       size_t last, float halfThick,
+                       std::vector<Vector2> *strip) {
+  Vector2 n0 = i > first ? segmentNormal(points[i - 1], points[i])
+                         : segmentNormal(points[i], points[i + 1]);
+  Vector2 n1 = i < last ? segmentNormal(points[i], points[i + 1]) : n0;
+
+  // miter: offset along the mean normal, long enough to keep the segment
+  // width, clamped at sharp turns
+  Vector2 miter = Vector2Add(n0, n1);
+  float length = sqrtf(miter.x * miter.x + miter.y * miter.y);
+  Vector2 offset = Vector2Scale(n0, halfThick);
+  if (length > 1e-6f) {
+    miter = Vector2Scale(miter, 1.0f / length);
+    float cosine = miter.x * n0.x + miter.y * n0.y;
+    float scale = halfThick / std::max(cosine, 0.5f);
+    offset = Vector2Scale(miter, scale);
+  }
+  strip->push_back(Vector2Add(points[i], offset));
+  strip->push_back(Vector2Subtract(points[i], offset));
+}
+
+void drawPolyline(const Vector2 *points, size_t count, float thick,
+                  Rectangle view, Color color, PolylineBuffer *buffer) {
+  if (count < 2) return;
+  float halfThick = 0.5f * thick;
+
+  // one strip per run of consecutive visible segments
+  std::vector<Vector2> *strip = &buffer->strip;
+  strip->clear();
+  buffer->runs.clear();
+  size_t i = 0;
+  while (i + 1 < count) {
+    if (!segmentVisible(points[i], points[i + 1], halfThick, view)) {
+      i++;
+      continue;
+    }
+    size_t first = i;
+    size_t last = i + 1;
+    while (last + 1 < count &&
+           segmentVisible(points[last], points[last + 1], halfThick, view)) {
+      last++;
+    }
+    buffer->runs.push_back(strip->size());
+    for (size_t k = first; k <= last; k++) {
+      appendJoin(points, k, first, last, halfThick, strip);
+    }
+    i = last;
+  }
+  if (strip->empty()) return;
+  buffer->runs.push_back(strip->size());
+
+  // rlgl has no strip primitive, each quad of a strip becomes two triangles
+  // (counter-clockwise on screen, so backface culling keeps them)
+  rlBegin(RL_TRIANGLES);
+  rlColor4ub(color.r, color.g, color.b, color.a);
+  for (size_t r = 0; r + 1 < buffer->runs.size(); r++) {
+    for (size_t k = buffer->runs[r]; k + 3 < buffer->runs[r + 1]; k += 2) {
+      const Vector2 *v = &(*strip)[k];
+      rlCheckRenderBatchLimit(6);
+      rlVertex2f(v[0].x, v[0].y);
+      rlVertex2f(v[2].x, v[2].y);
+      rlVertex2f(v[1].x, v[1].y);
+      rlVertex2f(v[2].x, v[2].y);
+      rlVertex2f(v[3].x, v[3].y);
+      rlVertex2f(v[1].x, v[1].y);
+    }
+  }
+  rlEnd();
+}
+
+Texture2D loadCircleSprite(int radius) {
+  Image image = GenImageColor(2 * radius, 2 * radius, BLANK);
+  ImageDrawCircle(&image, radius, radius, radius - 1, WHITE);
+  Texture2D sprite = LoadTextureFromImage(image);
+  UnloadImage(image);
+
+  // mipmaps keep zoomed out points smooth
+  GenTextureMipmaps(&sprite);
+  SetTextureFilter(sprite, TEXTURE_FILTER_TRILINEAR);
+  return sprite;
+}
+
+void drawPoints(const Vector2 *points, size_t count, float radius,
+                Rectangle view, Texture2D sprite, Color color) {
+  if (count == 0) return;
+  float left = view.x - radius, right = view.x + view.width + radius;
+  float top = view.y - radius, bottom = view.y + view.height + radius;
+
+  rlSetTexture(sprite.id);
+  rlBegin(RL_QUADS);
+  rlColor4ub(color.r, color.g, color.b, color.a);
+  rlNormal3f(0.0f, 0.0f, 1.0f);
+  for (size_t i = 0; i < count; i++) {
+    const Vector2 &p = points[i];
+    if (p.x < left || p.x > right || p.y < top || p.y > bottom) continue;
+
+    // same vertex order as DrawTexturePro()
+    rlCheckRenderBatchLimit(4);
+    rlTexCoord2f(0, 0);
+    rlVertex2f(p.x - radius, p.y - radius);
+    rlTexCoord2f(0, 1);
+    rlVertex2f(p.x - radius, p.y + radius);
+    rlTexCoord2f(1, 1);
+    rlVertex2f(p.x + radius, p.y + radius);
+    rlTexCoord2f(1, 0);
+    rlVertex2f(p.x + radius, p.y - radius);
+  }
+  rlEnd();
+  rlSetTexture(0);
+}
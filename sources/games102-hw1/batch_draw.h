@@ -0,0 +1,34 @@
+// Batched drawing for large point sets in games102-hw1
+//
+// Geometry outside the camera view is culled on the CPU and the rest is
+// submitted through rlgl as one batch, instead of one raylib shape call
+// (with its own tessellation and state setup) per segment or point.
+#ifndef BATCH_DRAW_H
+#define BATCH_DRAW_H
+
+#include <vector>
+
+#include "raylib.h"
+
+// World space rectangle visible through camera
+Rectangle cameraView(Camera2D camera, int screenWidth, int screenHeight);
+
+// Scratch storage of drawPolyline(), reused between frames
+struct PolylineBuffer {
+  std::vector<Vector2> strip;  // triangle-strip vertex pairs of all runs
+  std::vector<size_t> runs;    // first strip vertex of each run, plus end
+};
+
+// Draw connected segments points[i] - points[i + 1] with mitered joins
+void drawPolyline(const Vector2 *points, size_t count, float thick,
+                  Rectangle view, Color color, PolylineBuffer *buffer);
+
+// White filled circle texture used as point sprite, radius in texels
+Texture2D loadCircleSprite(int radius);
+
+// Draw a circle sprite of the given world radius at every visible point,
+// one textured quad per point
+void drawPoints(const Vector2 *points, size_t count, float radius,
+                Rectangle view, Texture2D sprite, Color color);
+
+#endif  // BATCH_DRAW_H
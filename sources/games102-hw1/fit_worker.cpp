@@ -0,0 +1,208 @@
+#include "fit_worker.h"
+
+#include <algorithm>  // Required for: std::min(), std::max()
+
+// Samples evaluated between two cancellation checks
+static const size_t SAMPLE_CHUNK = 4096;
+// Extra basis columns factorized beyond the requested order, so stepping the
+// order spinner up a little does not refactorize all points
+static const int ORDER_HEADROOM = 4;
+
+FitWorker::FitWorker()
+    : quit_(false),
+      hasPending_(false),
+      generation_(0),
+      cancels_(0),
+      running_(false),
+      hasReady_(false),
+      epoch_(0) {
+  thread_ = std::thread(&FitWorker::run, this);
+}
+
+FitWorker::~FitWorker() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    quit_ = true;
+    generation_++;
+    cancels_++;
+  }
+  cv_.notify_one();
+  thread_.join();
+}
+
+void FitWorker::submit(const std::vector<Vector2> &points,
+                       const curvefit::FitParams &params,
+                       const SampleSettings &sampling, bool incremental,
+                       unsigned epoch) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.refit = true;
+    pending_.points.assign(points.begin(), points.end());
+    pending_.params = params;
+    pending_.sampling = sampling;
+    pending_.incremental = incremental;
+    pending_.epoch = epoch;
+    hasPending_ = true;
+    generation_++;
+  }
+  cv_.notify_one();
+}
+
+void FitWorker::resample(const SampleSettings &sampling) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // a pending refit just takes the new settings
+    if (!hasPending_) pending_.refit = false;
+    pending_.sampling = sampling;
+    hasPending_ = true;
+    generation_++;
+  }
+  cv_.notify_one();
+}
+
+void FitWorker::cancel() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  hasPending_ = false;
+  hasReady_ = false;
+  generation_++;
+  cancels_++;
+}
+
+bool FitWorker::poll(std::vector<Vector2> *samples, curvefit::Curve *curve) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!hasReady_) return false;
+  samples->swap(ready_);
+  std::swap(*curve, readyCurve_);
+  hasReady_ = false;
+  return true;
+}
+
+bool FitWorker::busy() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hasPending_ || running_;
+}
+
+bool FitWorker::incrementalApplies(const curvefit::FitParams &params) {
+  return (params.type == curvefit::FITTING_ONE ||
+          params.type == curvefit::FITTING_TWO) &&
+         params.solver == curvefit::SOLVER_AUTO && !params.mixedPrecision;
+}
+
+bool FitWorker::cancelled(unsigned generation, unsigned cancels,
+                          bool refit) const {
+  // a newer job only supersedes resampling, the curve is unchanged for it
+  return cancels_ != cancels || (!refit && generation_ != generation);
+}
+
+curvefit::Curve FitWorker::fitCurve(const FitJob &job) {
+  if (job.epoch != epoch_) {
+    newton_.clear();
+    gauss_.clear();
+    lsq_.clear();
+    ridge_ = curvefit::RidgeSweep();
+    epoch_ = job.epoch;
+  }
+  if (job.points.size() < 2) return curvefit::Curve();
+
+  curvefit::PointSpan span =
+      curvefit::interleavedSpan(&job.points[0].x, job.points.size());
+  curvefit::Curve curve;
+  // only the points appended since the last fit are processed
+  bool incremental = job.incremental && incrementalApplies(job.params);
+  if (incremental && job.params.type == curvefit::FITTING_ONE &&
+      newton_.update(span)) {
+    curve = newton_.curve();
+  } else if (incremental && job.params.type == curvefit::FITTING_TWO) {
+    gauss_.setSigma(job.params.sigma);
+    if (gauss_.update(span)) curve = gauss_.curve();
+  } else if (job.params.solver == curvefit::SOLVER_AUTO &&
+             !job.params.mixedPrecision &&
+             job.params.order <= (int)job.points.size() &&
+             (job.params.type == curvefit::FITTING_THREE ||
+              job.params.type == curvefit::FITTING_FOUR)) {
+    // order and lambda changes reuse the factorization of the same points,
+    // an explicit solver or precision choice goes through fit() instead.
+    // The cache holds at most n columns, so orders above the point count
+    // go through fit() too, which fits every requested basis function
+    int order = std::max(job.params.order, 1);
+    if (lsq_.empty() || lsq_.size() != job.points.size() ||
+        lsq_.basis() != job.params.basis || lsq_.maxOrder() < order) {
+      lsq_.build(span, job.params.basis,
+                 std::max(order, std::min(order + ORDER_HEADROOM,
+                                          FIT_MAX_ORDER)));
+      ridge_ = curvefit::RidgeSweep();
+    }
+    if (job.params.type == curvefit::FITTING_THREE) {
+      curve = lsq_.solve(order);
+    } else {
+      if (ridge_.order() != order) {
+        ridge_ = curvefit::RidgeSweep(lsq_, order);
+      }
+      curve = ridge_.solve(job.params.autoLambda ? ridge_.bestLambda()
+                                                 : job.params.lambda);
+    }
+  }
+  if (curve.empty()) curve = curvefit::fit(span, job.params);
+  return curve;
+}
+
+void FitWorker::sampleCurve(const curvefit::Curve &curve,
+                            const SampleSettings &sampling,
+                            unsigned generation, unsigned cancels,
+                            bool refit) {
+  if (sampling.adaptive) {
+    curvefit::sampleAdaptive(curve, sampling.view, &adaptiveX_, &adaptiveY_);
+    back_.resize(adaptiveX_.size());
+    for (size_t i = 0; i < back_.size(); i++) {
+      back_[i].x = (float)adaptiveX_[i];
+      back_[i].y = (float)adaptiveY_[i];
+    }
+    return;
+  }
+
+  // cal sample points
+  size_t sampleNum = curvefit::sampleCount(curve, sampling.sampleRange);
+  back_.resize(sampleNum);
+  for (size_t i = 0;
+       i < sampleNum && !cancelled(generation, cancels, refit);
+       i += SAMPLE_CHUNK) {
+    size_t count = std::min(SAMPLE_CHUNK, sampleNum - i);
+    for (size_t k = i; k < i + count; k++) {
+      back_[k].x = (float)curvefit::sampleX(curve, sampling.sampleRange, k);
+    }
+    curvefit::evaluate(curve, &back_[i].x, 2, &back_[i].y, 2, count);
+  }
+}
+
+void FitWorker::run() {
+  FitJob job;
+  for (;;) {
+    unsigned generation, cancels;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return quit_ || hasPending_; });
+      if (quit_) return;
+      std::swap(job, pending_);
+      hasPending_ = false;
+      running_ = true;
+      generation = generation_;
+      cancels = cancels_;
+    }
+
+    // The job is the newest one when taken, so there is nothing stale to
+    // skip here. A refit that gets superseded while fitting is still
+    // published: during a drag every job may be superseded before it ends,
+    // dropping them all would freeze the curve until the mouse is released.
+    // The fit is kept even if cancelled, a following resample job uses it.
+    if (job.refit) curve_ = fitCurve(job);
+    sampleCurve(curve_, job.sampling, generation, cancels, job.refit);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+    if (!cancelled(generation, cancels, job.refit)) {
+      ready_.swap(back_);
+      readyCurve_ = curve_;
+      hasReady_ = true;
+    }
+  }
+}
@@ -0,0 +1,111 @@
+// Background fitting for games102-hw1
+//
+// The render thread submits snapshots of the points, the worker fits and
+// samples them, and the finished samples are swapped in by poll(). Only the
+// newest job is kept. A running refit still publishes its curve when a newer
+// job arrives, so the curve keeps up while jobs outpace the worker; a
+// running resample stops early instead. cancel() discards both.
+#ifndef FIT_WORKER_H
+#define FIT_WORKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "curvefit.h"
+#include "incremental.h"
+#include "least_squares.h"
+#include "raylib.h"
+#include "sampling.h"
+
+// Highest approximation order of the order spinner
+static const int FIT_MAX_ORDER = 30;
+
+struct SampleSettings {
+  bool adaptive;
+  float sampleRange;                // uniform spacing
+  curvefit::AdaptiveSampling view;  // adaptive: visible range and error
+
+  SampleSettings() : adaptive(false), sampleRange(5) {}
+};
+
+inline bool operator==(const SampleSettings &a, const SampleSettings &b) {
+  return a.adaptive == b.adaptive &&
+         (a.adaptive ? a.view == b.view : a.sampleRange == b.sampleRange);
+}
+inline bool operator!=(const SampleSettings &a, const SampleSettings &b) {
+  return !(a == b);
+}
+
+struct FitJob {
+  bool refit;  // false only resamples the last fitted curve
+  std::vector<Vector2> points;
+  curvefit::FitParams params;
+  SampleSettings sampling;
+  bool incremental;  // reuse interpolators for FITTING_ONE/TWO
+  unsigned epoch;    // changes whenever existing points are edited or removed
+
+  FitJob() : refit(true), incremental(true), epoch(0) {}
+};
+
+class FitWorker {
+ public:
+  FitWorker();
+  ~FitWorker();
+
+  // Queue a job, replacing the pending one
+  void submit(const std::vector<Vector2> &points,
+              const curvefit::FitParams &params, const SampleSettings &sampling,
+              bool incremental, unsigned epoch);
+  // Sample the last fitted curve again, e.g. when the view changes
+  void resample(const SampleSettings &sampling);
+  // Drop the pending job and discard the result of the running one
+  void cancel();
+  // Swap the newest finished samples and their curve in, false if none is
+  // ready
+  bool poll(std::vector<Vector2> *samples, curvefit::Curve *curve);
+  // A job is pending or running
+  bool busy() const;
+  // Incremental jobs with these settings reuse the previous solve: Newton
+  // form for FITTING_ONE, whatever the basis, and a Cholesky update for
+  // FITTING_TWO. An explicit solver or float32 solve always goes through
+  // fit()
+  static bool incrementalApplies(const curvefit::FitParams &params);
+
+ private:
+  void run();
+  // the job taken at generation/cancels should stop without a result
+  bool cancelled(unsigned generation, unsigned cancels, bool refit) const;
+  curvefit::Curve fitCurve(const FitJob &job);
+  void sampleCurve(const curvefit::Curve &curve, const SampleSettings &sampling,
+                   unsigned generation, unsigned cancels, bool refit);
+
+  std::thread thread_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool quit_;
+
+  FitJob pending_;
+  bool hasPending_;
+  std::atomic<unsigned> generation_;  // id of the newest submitted job
+  std::atomic<unsigned> cancels_;     // bumped by cancel() and on quit
+  std::atomic<bool> running_;
+
+  std::vector<Vector2> back_;   // written by the worker
+  std::vector<Vector2> ready_;  // finished, waiting for poll()
+  curvefit::Curve readyCurve_;
+  bool hasReady_;
+
+  // worker thread only
+  curvefit::Curve curve_;  // last fitted curve, kept for resampling
+  std::vector<double> adaptiveX_, adaptiveY_;
+  curvefit::NewtonInterpolator newton_;
+  curvefit::GaussInterpolator gauss_;
+  curvefit::LeastSquaresCache lsq_;
+  curvefit::RidgeSweep ridge_;  // SVD of lsq_ for lambda changes
+  unsigned epoch_;
+};
+
+#endif  // FIT_WORKER_H
@@ -1,8 +1,14 @@
-#include <Eigen/Dense>
-#include <cmath>  // Required for: pow(), ceil(), exp()
+#include <cmath>  // Required for: pow()
 #include <iostream>
 #include <vector>
 
+#include "batch_draw.h"
+#include "curve_io.h"
+#include "curvefit.h"
+#include "fit_worker.h"
+#include "point_grid.h"
+#include "point_io.h"
+#include "solver.h"
 #include "raylib.h"
 #include "raymath.h"
 #include "rlgl.h"  // Required for: rl*()
@@ -10,25 +16,27 @@
 #define RAYGUI_IMPLEMENTATION
 #include "raygui.h"
 
-using Eigen::MatrixXd;
-using Eigen::VectorXd;
+using curvefit::FITTING_ONE;
 
-typedef enum {
-  FITTING_ONE = 0,  // 插值 幂基函数线性组合
-  FITTING_TWO,      // 插值 Gauss基函数线性组合
-  FITTING_THREE,    // 逼近 固定幂基函数，最小二乘
-  FITTING_FOUR      // 逼近 岭回归
-} FittingType;
+// entries of the basis dropdown
+static const curvefit::BasisType polyBases[] = {
+    curvefit::BASIS_POWER, curvefit::BASIS_CHEBYSHEV, curvefit::BASIS_LEGENDRE};
 
-float guassBasisFunc(float x, float x0, float sigma) {
-  return exp(-(pow(x - x0, 2)) / (2 * pow(sigma, 2)));
+static_assert(sizeof(Vector2) == 2 * sizeof(float),
+              "curvefit views Vector2 arrays as interleaved floats");
+
+// Row text of the points table, only called for the visible rows
+static const char *pointRowText(int index, void *userData) {
+  const std::vector<Vector2> &points = *(const std::vector<Vector2> *)userData;
+  return TextFormat("%d: %.1f, %.1f", index, points[index].x,
+                    points[index].y);
 }
 
 int main(void) {
   // Initialization
   // ---------------------------------------------------------------------------
   const int screenWidth = 800;
-  const int screenHeight = 450;
+  const int screenHeight = 720;
   InitWindow(screenWidth, screenHeight, "GAMES102-hw1");
 
   Camera2D camera = {0};
@@ -42,13 +50,39 @@ int main(void) {
   bool sampleRangeEditMode = false;
   bool clearPoints = false;
   bool calculateFitting = false;
+  bool exportFitting = false;
+  bool incrementalFitting = true;  // reuse previous solve for FITTING_ONE/TWO
+  bool autoRefit = false;          // refit on every point edit
+  bool adaptiveSampling = false;   // sample the visible range by curvature
+  bool mixedPrecision = false;     // float32 solve refined in double
+  bool basisEditMode = false;
+  int basisActive = 0;  // index into polyBases
+  bool solverEditMode = false;
+  int solverActive = curvefit::SOLVER_AUTO;
   int sampleRange = 5;
-  const double sigma = 20;    // * for guass basis
-  const double lambda = 0.1;  // * for ridge regression
+  bool orderEditMode = false;
+  int order = 2;  // * for least squares and ridge regression
+  const double sigma = 20;     // * for guass basis
+  const double support = 100;  // * for compact support basis
+  float lambdaLog = -1;        // * for ridge regression, lambda = 10^lambdaLog
+  bool autoLambda = false;     // pick lambda by GCV
 
   // Data
   std::vector<Vector2> points;
   std::vector<Vector2> samplePoints;
+  curvefit::Curve curve;  // curve of samplePoints
+  bool pointsChanged = false;
+  unsigned pointsEpoch = 0;  // bumped when points are moved or removed
+  PointGrid pointGrid;       // picking without scanning every point
+  int selectedPoint = -1;
+  bool draggingPoint = false;
+  const float pickRadius = 8;  // radius the points are drawn with
+  int pointsScroll = 0;        // first visible row of the points table
+  FitWorker fitWorker;
+  PolylineBuffer curveBuffer;
+  Texture2D pointSprite = loadCircleSprite(32);
+  curvefit::FitParams lastParams;  // settings of the last submitted fit
+  SampleSettings lastSampling;     // sampling of the last submitted job
 
   SetTargetFPS(60);
 
@@ -65,7 +99,9 @@ int main(void) {
       camera.target = Vector2Add(camera.target, delta);
     }
 
-    if (zoomMode == 0) {
+    // the wheel scrolls the points table while over the right bar
+    if (zoomMode == 0 &&
+        !CheckCollisionPointRec(GetMousePosition(), rightBar)) {
       float wheel = GetMouseWheelMove();
       if (wheel != 0) {
         Vector2 mouseWorldPos = GetScreenToWorld2D(GetMousePosition(), camera);
@@ -79,98 +115,144 @@ int main(void) {
     }
 
     // separate two part
+    // left click picks a point to drag, or adds one on empty space
+    Vector2 mouseWorld = GetScreenToWorld2D(GetMousePosition(), camera);
     if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) &&
         !CheckCollisionPointRec(GetMousePosition(), rightBar)) {
-      Vector2 point = GetScreenToWorld2D(GetMousePosition(), camera);
-      points.push_back(point);
+      selectedPoint = pointGrid.pick(points, mouseWorld, pickRadius);
+      if (selectedPoint >= 0) {
+        draggingPoint = true;
+      } else {
+        points.push_back(mouseWorld);
+        pointGrid.insert((int)points.size() - 1, mouseWorld);
+        pointsChanged = true;
+      }
     }
-
-    if (calculateFitting) {
-      if (points.size() > 1) {
-        // A * alpha = B
-        int n = points.size();
-        int order = fittingTypeActive == FITTING_THREE ||
-                            fittingTypeActive == FITTING_FOUR
-                        ? 2
-                        : n;  // TODO: 2 order
-        VectorXd alpha(order);
-        VectorXd Y(n);
-        MatrixXd A(n, order);
-        double xMin = points[0].x, xMax = points[0].x;
-
-        // initialize
-        for (int i = 0; i < n; i++) {
-          // cal sample range
-          if (points[i].x > xMax) {
-            xMax = points[i].x;
-          }
-
-          if (points[i].x < xMin) {
-            xMin = points[i].x;
-          }
-
-          if (fittingTypeActive == FITTING_ONE ||
-              fittingTypeActive == FITTING_THREE ||
-              fittingTypeActive == FITTING_FOUR) {
-            for (int j = 0; j < order; j++) {
-              A(i, j) = pow(points[i].x, j);  // 幂基函数的线性组合
-            }
-          } else if (fittingTypeActive == FITTING_TWO) {
-            A(i, 0) = 1;
-            for (int j = 1; j < order; j++) {
-              A(i, j) = guassBasisFunc(points[i].x, points[j].x,
-                                       sigma);  // Gauss基函数的线性组合
-            }
-          }
-
-          Y(i) = points[i].y;
+    if (draggingPoint) {
+      if (IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
+        Vector2 &point = points[selectedPoint];
+        if (point.x != mouseWorld.x || point.y != mouseWorld.y) {
+          pointGrid.move(selectedPoint, point, mouseWorld);
+          point = mouseWorld;
+          // Moves and deletes are not appends: the incremental solver has no
+          // local update for them, so the next fit restarts from scratch and
+          // drops every cache. Auto refits below are held back while the
+          // worker is busy, so a drag refits at the worker's pace.
+          pointsEpoch++;
+          pointsChanged = true;
         }
+      } else {
+        draggingPoint = false;
+      }
+    }
 
-        if (fittingTypeActive == FITTING_ONE ||
-            fittingTypeActive == FITTING_TWO) {
-          // interpolatioin
-          alpha = A.colPivHouseholderQr().solve(Y);
-        } else if (fittingTypeActive == FITTING_THREE) {
-          // regression
-          alpha = A.bdcSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(Y);
-        } else if (fittingTypeActive == FITTING_FOUR) {
-          // regression
-          MatrixXd AtA = A.transpose() * A;
-          MatrixXd lambdaI = MatrixXd::Identity(order, order) * lambda;
-          MatrixXd A1 = AtA + lambdaI;
-          alpha = A1.ldlt().solve(A.transpose() * Y);
+    // delete the selected point, or the one under the mouse
+    if (IsKeyPressed(KEY_DELETE) || IsKeyPressed(KEY_BACKSPACE)) {
+      int index = selectedPoint >= 0
+                      ? selectedPoint
+                      : pointGrid.pick(points, mouseWorld, pickRadius);
+      if (index >= 0) {
+        removePoint(&points, &pointGrid, index);
+        selectedPoint = -1;
+        draggingPoint = false;
+        pointsEpoch++;
+        pointsChanged = true;
+      }
+    }
+
+    // dropped CSV/binary files are appended as points, in world coordinates
+    if (IsFileDropped()) {
+      FilePathList dropped = LoadDroppedFiles();
+      for (unsigned int i = 0; i < dropped.count; i++) {
+        curvefit::PointFile file;
+        if (!file.load(dropped.paths[i])) {
+          TraceLog(LOG_WARNING, "Could not load points from %s",
+                   dropped.paths[i]);
+          continue;
         }
-        // std::cout << alpha << std::endl;
-
-        // cal sample points
-        samplePoints.clear();
-        int sampleNum = (int)ceil((xMax - xMin) / sampleRange);
-        for (int i = 0; i < sampleNum; i++) {
-          Vector2 samplePoint{0, 0};
-          samplePoint.x = xMin + i * sampleRange;
-          if (fittingTypeActive == FITTING_ONE ||
-              fittingTypeActive == FITTING_THREE ||
-              fittingTypeActive == FITTING_FOUR) {
-            for (int j = 0; j < order; j++) {
-              samplePoint.y += alpha(j) * pow(samplePoint.x, j);
-            }
-          } else if (fittingTypeActive == FITTING_TWO) {
-            samplePoint.y = alpha(0);
-            for (int j = 1; j < order; j++) {
-              samplePoint.y +=
-                  alpha(j) * guassBasisFunc(samplePoint.x, points[j].x, sigma);
-            }
-          }
-          samplePoints.push_back(samplePoint);
+        const Vector2 *xy = (const Vector2 *)file.xy();
+        size_t first = points.size();
+        points.insert(points.end(), xy, xy + file.size());
+        for (size_t j = first; j < points.size(); j++) {
+          pointGrid.insert((int)j, points[j]);
         }
+        pointsChanged = true;
       }
+      UnloadDroppedFiles(dropped);
+    }
+
+    curvefit::FitParams params;
+    params.type = (curvefit::FittingType)fittingTypeActive;
+    params.basis = polyBases[basisActive];
+    params.order = order;
+    params.sigma = sigma;
+    params.support = support;
+    params.lambda = pow(10.0, lambdaLog);
+    params.autoLambda = autoLambda;
+    params.solver = (curvefit::SolverType)solverActive;
+    params.mixedPrecision = mixedPrecision;
+    if (autoRefit && params != lastParams) pointsChanged = true;
+
+    // adaptive samples cover the visible x range, with errors and steps
+    // measured in screen pixels
+    SampleSettings sampling;
+    sampling.adaptive = adaptiveSampling;
+    sampling.sampleRange = sampleRange;
+    if (adaptiveSampling) {
+      sampling.view.x0 = GetScreenToWorld2D(Vector2{0, 0}, camera).x;
+      sampling.view.x1 =
+          GetScreenToWorld2D(Vector2{(float)GetScreenWidth(), 0}, camera).x;
+      sampling.view.tolerance = 0.5 / camera.zoom;
+      sampling.view.minStep = 0.5 / camera.zoom;
+      sampling.view.maxStep = 32 / camera.zoom;
+    }
+
+    // automatic refits wait for the running job; pointsChanged stays set so
+    // the latest points go out as soon as the worker is free
+    if (calculateFitting ||
+        (autoRefit && pointsChanged && !fitWorker.busy())) {
+      fitWorker.submit(points, params, sampling, incrementalFitting,
+                       pointsEpoch);
+      lastParams = params;
+      lastSampling = sampling;
 
       calculateFitting = false;
+      pointsChanged = false;
+    } else if (!curve.empty() && sampling != lastSampling) {
+      // only the view or spacing changed, no refit
+      fitWorker.resample(sampling);
+      lastSampling = sampling;
+    }
+
+    // swap in finished samples, drawing never waits for the worker
+    fitWorker.poll(&samplePoints, &curve);
+
+    // coefficients and uniform samples at the current sample range, next to
+    // the executable's working directory
+    if (exportFitting) {
+      if (curve.empty()) {
+        TraceLog(LOG_WARNING, "No fitted curve to export");
+      } else if (curvefit::exportCurve("curve.bin", curvefit::EXPORT_BINARY,
+                                       curve, sampleRange) &&
+                 curvefit::exportCurve("curve.csv", curvefit::EXPORT_CSV,
+                                       curve, sampleRange)) {
+        TraceLog(LOG_INFO, "Exported curve.bin and curve.csv");
+      } else {
+        TraceLog(LOG_WARNING, "Could not export the curve");
+      }
+      exportFitting = false;
     }
 
     if (clearPoints) {
+      fitWorker.cancel();
       points.clear();
+      pointGrid.clear();
+      selectedPoint = -1;
+      draggingPoint = false;
       samplePoints.clear();
+      curve = curvefit::Curve();
+      pointsEpoch++;
+      pointsChanged = true;
       clearPoints = false;
     }
 
@@ -180,6 +262,8 @@ int main(void) {
     ClearBackground(RAYWHITE);
 
     BeginMode2D(camera);
+    const Rectangle view =
+        cameraView(camera, GetScreenWidth(), GetScreenHeight());
 
     // Draw the 3d grid, rotated 90 degrees and centered around 0,0
     // just so we have something in the XY plane
@@ -195,16 +279,15 @@ int main(void) {
     DrawCircle(0, 0, 10, YELLOW);
 
     // Draw points
-    for (auto it = points.begin(); it != points.end(); it++) {
-      DrawCircle((*it).x, (*it).y, 8, SKYBLUE);
+    drawPoints(points.data(), points.size(), pickRadius, view, pointSprite,
+               SKYBLUE);
+    if (selectedPoint >= 0) {
+      DrawCircleLinesV(points[selectedPoint], pickRadius + 2, ORANGE);
     }
 
-    if (samplePoints.size() > 1) {
-      // Draw Fitting Line
-      for (int i = 0; i < samplePoints.size() - 1; i++) {
-        DrawLineEx(samplePoints[i], samplePoints[i + 1], 2, RED);
-      }
-    }
+    // Draw Fitting Line
+    drawPolyline(samplePoints.data(), samplePoints.size(), 2, view, RED,
+                 &curveBuffer);
 
     EndMode2D();
 
@@ -223,27 +306,109 @@ int main(void) {
 
     // Draw GUI controls
     // Check all possible UI states that require controls lock
-    if (fittingTypeEditMode) GuiLock();
+    if (fittingTypeEditMode || basisEditMode || solverEditMode) GuiLock();
 
-    GuiLabel(Rectangle{rightPos, 10 + 24 + 28, 140, 24}, "Sample Range:");
-    if (GuiSpinner(Rectangle{rightPos, 10 + 24 + 28 + 24, 140, 24}, "",
-                   &sampleRange, 1, 100, sampleRangeEditMode))
+    // dropdowns are drawn last, on top of the controls below them
+    const Rectangle fittingTypeRec = {rightPos, 10 + 24, 140, 28};
+    const Rectangle basisRec = {rightPos, 10 + 24 + 28 + 24, 140, 28};
+    const Rectangle solverRec = {rightPos, basisRec.y + 28 + 24, 140, 28};
+    GuiLabel(Rectangle{rightPos, 10, 140, 24}, "Fitting type:");
+    // incremental interpolation is built in Newton form, the basis choice
+    // does not apply to it
+    bool newtonBasis = incrementalFitting &&
+                       params.type == curvefit::FITTING_ONE &&
+                       FitWorker::incrementalApplies(params);
+    GuiLabel(Rectangle{rightPos, 10 + 24 + 28, 140, 24},
+             newtonBasis ? "Basis: (Newton)" : "Basis:");
+    // AUTO shows the decomposition it picked for the current curve
+    bool showSolver = (solverActive == curvefit::SOLVER_AUTO ||
+                       mixedPrecision) &&
+                      !curve.empty() && curve.solver != curvefit::SOLVER_AUTO;
+    GuiLabel(Rectangle{rightPos, basisRec.y + 28, 140, 24},
+             showSolver ? TextFormat("Solver: (%s%s)",
+                                     curvefit::solverName(curve.solver),
+                                     curve.mixedPrecision ? " f32" : "")
+                        : "Solver:");
+
+    float barY = solverRec.y + solverRec.height;
+    GuiLabel(Rectangle{rightPos, barY, 140, 24}, "Sample Range:");
+    if (GuiSpinner(Rectangle{rightPos, barY + 24, 140, 24}, "", &sampleRange,
+                   1, 100, sampleRangeEditMode))
       sampleRangeEditMode = !sampleRangeEditMode;
-
-    if (GuiButton(Rectangle{rightPos, 10 + 24 + 28 + 24 + 24, 140, 24},
-                  "#191#Clear Points"))
+    barY += 24 + 24;
+
+    GuiLabel(Rectangle{rightPos, barY, 140, 24}, "Order:");
+    if (GuiSpinner(Rectangle{rightPos, barY + 24, 140, 24}, "", &order, 1,
+                   FIT_MAX_ORDER, orderEditMode))
+      orderEditMode = !orderEditMode;
+    barY += 24 + 24;
+
+    // ridge lambda on a log scale, shows the GCV choice when automatic
+    GuiLabel(Rectangle{rightPos, barY, 140, 24},
+             TextFormat("Lambda: %.3g", autoLambda && curve.lambda > 0
+                                            ? curve.lambda
+                                            : pow(10.0, lambdaLog)));
+    if (autoLambda) GuiDisable();
+    GuiSlider(Rectangle{rightPos, barY + 24, 140, 16}, nullptr, nullptr,
+              &lambdaLog, -6, 3);
+    GuiEnable();
+    GuiCheckBox(Rectangle{rightPos, barY + 24 + 20, 20, 20}, "Auto (GCV)",
+                &autoLambda);
+    barY += 24 + 20 + 24 + 4;
+
+    if (GuiButton(Rectangle{rightPos, barY, 68, 24}, "#191#Clear"))
       clearPoints = true;
+    if (GuiButton(Rectangle{rightPos + 72, barY, 68, 24}, "#7#Export"))
+      exportFitting = true;
+    barY += 24 + 4;
 
-    if (GuiButton(Rectangle{rightPos, 10 + 24 + 28 + 24 + 28 + 24, 140, 24},
-                  "Calculate Fitting"))
+    if (GuiButton(Rectangle{rightPos, barY, 140, 24}, "Calculate Fitting"))
       calculateFitting = true;
+    barY += 24 + 4;
+
+    GuiCheckBox(Rectangle{rightPos, barY, 20, 20}, "Incremental",
+                &incrementalFitting);
+    barY += 24;
+    GuiCheckBox(Rectangle{rightPos, barY, 20, 20}, "Auto Refit", &autoRefit);
+    barY += 24;
+    GuiCheckBox(Rectangle{rightPos, barY, 20, 20}, "Adaptive Sampling",
+                &adaptiveSampling);
+    barY += 24;
+    GuiCheckBox(Rectangle{rightPos, barY, 20, 20}, "Float32 Solve",
+                &mixedPrecision);
+    barY += 24;
+    if (fitWorker.busy()) {
+      GuiLabel(Rectangle{rightPos, barY, 140, 24}, "Fitting...");
+    }
+    barY += 24;
+
+    // every point as a row, picking a row selects the point
+    GuiLabel(Rectangle{rightPos, barY, 140, 24},
+             TextFormat("Points: %d", (int)points.size()));
+    barY += 24;
+    int listSelected = selectedPoint;
+    GuiListViewVirtual(
+        Rectangle{rightPos, barY, 140, GetScreenHeight() - barY - 10},
+        pointRowText, &points, (int)points.size(), &pointsScroll,
+        &listSelected, nullptr);
+    if (listSelected != selectedPoint) {
+      selectedPoint = listSelected;
+      draggingPoint = false;
+    }
 
     GuiUnlock();
 
-    GuiLabel(Rectangle{rightPos, 10, 140, 24}, "Fitting type:");
-    if (GuiDropdownBox(Rectangle{rightPos, 10 + 24, 140, 28},
-                       "ONE;TWO;THREE;FOUR", &fittingTypeActive,
-                       fittingTypeEditMode))
+    if (GuiDropdownBox(solverRec, "AUTO;LLT;LDLT;QR;SVD;LU", &solverActive,
+                       solverEditMode))
+      solverEditMode = !solverEditMode;
+    if (newtonBasis) GuiDisable();
+    if (GuiDropdownBox(basisRec, "POWER;CHEBYSHEV;LEGENDRE", &basisActive,
+                       basisEditMode))
+      basisEditMode = !basisEditMode;
+    GuiEnable();
+    if (GuiDropdownBox(fittingTypeRec,
+                       "ONE;TWO;THREE;FOUR;FIVE;SIX;SEVEN;EIGHT",
+                       &fittingTypeActive, fittingTypeEditMode))
       fittingTypeEditMode = !fittingTypeEditMode;
 
     EndDrawing();
@@ -251,6 +416,8 @@ int main(void) {
 
   // De-Initializatoin
   // ---------------------------------------------------------------------------
+  UnloadTexture(pointSprite);
+  GuiUnloadIcons();
   CloseWindow();
 
   return 0;
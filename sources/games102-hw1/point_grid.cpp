@@ -0,0 +1,67 @@
+#include "point_grid.h"
+
+#include <algorithm>  // Required for: std::find()
+#include <cmath>      // Required for: floorf()
+
+int PointGrid::cellOf(float v) const { return (int)floorf(v / cellSize_); }
+
+void PointGrid::build(const std::vector<Vector2> &points) {
+  clear();
+  for (size_t i = 0; i < points.size(); i++) insert((int)i, points[i]);
+}
+
+void PointGrid::insert(int index, Vector2 position) {
+  cells_[key(cellOf(position.x), cellOf(position.y))].push_back(index);
+}
+
+void PointGrid::remove(int index, Vector2 position) {
+  auto cell = cells_.find(key(cellOf(position.x), cellOf(position.y)));
+  if (cell == cells_.end()) return;
+  std::vector<int> &indices = cell->second;
+  auto it = std::find(indices.begin(), indices.end(), index);
+  if (it == indices.end()) return;
+  *it = indices.back();
+  indices.pop_back();
+  if (indices.empty()) cells_.erase(cell);
+}
+
+void PointGrid::move(int index, Vector2 from, Vector2 to) {
+  if (cellOf(from.x) == cellOf(to.x) && cellOf(from.y) == cellOf(to.y)) return;
+  remove(index, from);
+  insert(index, to);
+}
+
+int PointGrid::pick(const std::vector<Vector2> &points, Vector2 position,
+                    float radius) const {
+  int best = -1;
+  float bestDistance2 = radius * radius;
+  for (int cx = cellOf(position.x - radius); cx <= cellOf(position.x + radius);
+       cx++) {
+    for (int cy = cellOf(position.y - radius);
+         cy <= cellOf(position.y + radius); cy++) {
+      auto cell = cells_.find(key(cx, cy));
+      if (cell == cells_.end()) continue;
+      for (int index : cell->second) {
+        float dx = points[index].x - position.x;
+        float dy = points[index].y - position.y;
+        float distance2 = dx * dx + dy * dy;
+        if (distance2 <= bestDistance2) {
+          best = index;
+          bestDistance2 = distance2;
+        }
+      }
+    }
+  }
+  return best;
+}
+
+void removePoint(std::vector<Vector2> *points, PointGrid *grid, int index) {
+  int last = (int)points->size() - 1;
+  grid->remove(index, (*points)[index]);
+  if (index != last) {
+    grid->remove(last, (*points)[last]);
+    grid->insert(index, (*points)[last]);
+    (*points)[index] = (*points)[last];
+  }
+  points->pop_back();
+}
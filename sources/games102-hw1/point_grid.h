@@ -0,0 +1,45 @@
+// Uniform grid over the world positions of the control points
+//
+// Points are bucketed by cell, so finding the point under the mouse only
+// looks at the cells around it instead of scanning every point.
+#ifndef POINT_GRID_H
+#define POINT_GRID_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "raylib.h"
+
+class PointGrid {
+ public:
+  explicit PointGrid(float cellSize = 32) : cellSize_(cellSize) {}
+
+  void clear() { cells_.clear(); }
+  void build(const std::vector<Vector2> &points);
+
+  void insert(int index, Vector2 position);
+  void remove(int index, Vector2 position);
+  void move(int index, Vector2 from, Vector2 to);
+
+  // Index of the point nearest to position within radius, -1 if none
+  int pick(const std::vector<Vector2> &points, Vector2 position,
+           float radius) const;
+
+ private:
+  typedef long long CellKey;
+
+  int cellOf(float v) const;
+  static CellKey key(int cx, int cy) {
+    return (CellKey)(((unsigned long long)(unsigned)cx << 32) |
+                     (unsigned)cy);
+  }
+
+  std::unordered_map<CellKey, std::vector<int> > cells_;
+  float cellSize_;
+};
+
+// Remove points[index] by moving the last point into its slot, keeping the
+// grid in sync
+void removePoint(std::vector<Vector2> *points, PointGrid *grid, int index);
+
+#endif  // POINT_GRID_H